@@ -3,6 +3,9 @@
 #include "Action.h"
 #include "GameFramework/Actor.h"
 #include "ActionComponent.h"
+#include "ActionStats.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hook Tables"), STAT_ActionHookTables, STATGROUP_ActionComponent);
 
 void FAction::SetOwner(AActor* InOwner)
 {
@@ -14,7 +17,83 @@ void FAction::SetActionComponent(UActionComponent* InActionComponent)
 	ActionComponent = InActionComponent;
 }
 
-void FAction::NotifyActionFinish(EActionResult Result, const FString& Reason /*= EActionFinishReason::UnKnown*/)
+const FActionOwnerContext& FAction::GetOwnerContext() const
+{
+	static const FActionOwnerContext EmptyContext;
+	UActionComponent* Component = GetActionComponent();
+	return Component ? Component->GetOwnerContext() : EmptyContext;
+}
+
+TArray<const FAction*> FAction::GetActiveActions() const
+{
+	TArray<const FAction*> Ret;
+	ForEachActiveAction([&Ret](const FAction* Action) { Ret.Add(Action); return true; });
+	return Ret;
+}
+
+FActionHooks& FAction::EditHooks()
+{
+	if (!Hooks.IsValid())
+	{
+		INC_DWORD_STAT(STAT_ActionHookTables);
+		Hooks = MakeShared<FActionHooks>();
+	}
+	else if (!Hooks.IsUnique())
+	{
+		INC_DWORD_STAT(STAT_ActionHookTables);
+		Hooks = MakeShared<FActionHooks>(*Hooks);
+	}
+	return *Hooks;
+}
+
+FActionCompletion::~FActionCompletion()
+{
+	if (!Future.IsReady())
+	{
+		Promise.SetValue(FActionOutcome{ EActionResult::Abort, EActionFinishReason::UnKnown });
+	}
+}
+
+TSharedFuture<FActionOutcome> FAction::GetCompletion()
+{
+	if (!Completion.IsValid())
+	{
+		Completion = MakeShared<FActionCompletion>();
+		Completion->Future = Completion->Promise.GetFuture().Share();
+	}
+	return Completion->Future;
+}
+
+void FAction::Complete(EActionResult InResult, const FActionFinishReason& Reason)
+{
+	if (!Completion.IsValid())
+		return;
+	TSharedPtr<FActionCompletion> Finished = MoveTemp(Completion);
+	Finished->Promise.SetValue(FActionOutcome{ InResult, Reason });
+}
+
+void FAction::ResetAction()
+{
+	*this = FAction();
+}
+
+TSharedPtr<FAction> FAction::CloneAction() const
+{
+	ensureMsgf(false, TEXT("%s does not override CloneAction, its copy would be sliced down to a bare FAction"), *GetName().ToString());
+	return nullptr;
+}
+
+void FAction::DetachCopy()
+{
+	ParentAction = nullptr;
+	Owner = nullptr;
+	ActionComponent = nullptr;
+	SlotIndex = INDEX_NONE;
+	IndexInParent = INDEX_NONE;
+	Completion.Reset();
+}
+
+void FAction::NotifyActionFinish(EActionResult Result, const FActionFinishReason& Reason /*= EActionFinishReason::UnKnown*/)
 {
 	if (ParentAction.IsValid())
 		ParentAction.Pin()->FinishChildAction(this, Result, Reason);
@@ -24,24 +103,56 @@ void FAction::NotifyActionFinish(EActionResult Result, const FString& Reason /*=
 
 void FAction::NotifyTypeChanged()
 {
-	EActionType ActionType = Type;
-	UpdateType();
-	if (ActionType == Type)
-		return;
-	if (ParentAction.IsValid())
-		ParentAction.Pin()->NotifyTypeChanged();
-	else if (ActionComponent.IsValid())
-		ActionComponent->ActionTypeChanged(this, ActionType);
+	NotifyActiveActionsChanged();
+	TSharedPtr<FAction> Parent;
+	for (FAction* Action = this; !Action->bTypeDirty; Action = Parent.Get())
+	{
+		Action->bTypeDirty = true;
+		Parent = Action->ParentAction.Pin();
+		if (!Parent.IsValid())
+		{
+			if (Action->ActionComponent.IsValid())
+				Action->ActionComponent->MarkActionTypeDirty(Action);
+			return;
+		}
+	}
+}
+
+void FAction::ResolveType() const
+{
+	FAction* MutableThis = const_cast<FAction*>(this);
+	MutableThis->bTypeDirty = false;
+	MutableThis->UpdateType();
+}
 
+float FAction::GetActionTime() const
+{
+	return ActionComponent.IsValid() ? ActionComponent->GetActionTime() : 0.0f;
+}
+
+void FAction::RequestTick()
+{
+	if (ActionComponent.IsValid())
+		ActionComponent->WakeActionTick();
 }
 
-bool FAction::DoFinishAction(EActionResult InResult, const FString& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
+void FAction::NotifyActiveActionsChanged()
+{
+	if (ActionComponent.IsValid())
+		ActionComponent->InvalidateActiveLeafActions();
+}
+
+bool FAction::DoFinishAction(EActionResult InResult, const FActionFinishReason& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
 {
 	if (FinishAction(InResult, Reason, StopType))
 	{
 		if (InResult != EActionResult::Clean)
 		{
-			PostFinish.ExecuteIfBound(this, InResult, Reason);
+			ExecutePostFinish(InResult, Reason);
+		}
+		else if (Completion.IsValid())
+		{
+			Complete(InResult, Reason);
 		}
 		return true;
 	}
@@ -50,20 +161,27 @@ bool FAction::DoFinishAction(EActionResult InResult, const FString& Reason /*= E
 
 EActionResult FAction::DoExecuteAction()
 {
-	EActionResult Result = EActionResult::Fail;
-	bool PrerequisiteResult = true;
-	if (Prerequisite.IsBound())
-	{
-		PrerequisiteResult = Prerequisite.Execute(this);
-	}
-	if (PrerequisiteResult)
+	if (Hooks.IsValid())
 	{
-		PreExecute.ExecuteIfBound(this);
-		Result = ExecuteAction();
-		if (Result != EActionResult::Wait)
+		if (Hooks->Prerequisite.IsBound() && !Hooks->Prerequisite.Execute(this))
 		{
-			PostFinish.ExecuteIfBound(this, Result, EActionFinishReason::UnKnown);
+			if (Completion.IsValid())
+			{
+				Complete(EActionResult::Fail, EActionFinishReason::Rejected);
+			}
+			return EActionResult::Fail;
 		}
+		Hooks->PreExecute.ExecuteIfBound(this);
+	}
+
+	const EActionResult Result = ExecuteAction();
+	if (Result != EActionResult::Wait)
+	{
+		ExecutePostFinish(Result, EActionFinishReason::UnKnown);
+	}
+	else if (ActionComponent.IsValid() && NeedsTick())
+	{
+		ActionComponent->WakeActionTick();
 	}
 	return Result;
 }
@@ -3,21 +3,64 @@
 #pragma once
 
 #include "SharedPointer.h"
+#include "Templates/Function.h"
+#include "Async/Future.h"
 #include "WeakObjectPtrTemplates.h"
 #include "ActionEnums.h"
+#include "ActionCallback.h"
+#include "ActionOwnerContext.h"
 
 class AActor;
 class UActionComponent;
+class FAction;
 
-class NEWPROJECT_API FAction : public TSharedFromThis<FAction>
+/** Callbacks of an action, kept out of FAction since most actions never bind any. */
+struct FActionHooks
+{
+	/** Checked before the action executes, it fails without executing when this returns false. */
+	TActionCallback<bool(FAction*)> Prerequisite;
+	TActionCallback<void(FAction*)> PreExecute;
+	TActionCallback<void(FAction*, EActionResult, const FActionFinishReason&)> PostFinish;
+
+	bool IsAnyBound() const { return Prerequisite.IsBound() || PreExecute.IsBound() || PostFinish.IsBound(); }
+};
+
+/** How an action ended, what its completion future carries. */
+struct FActionOutcome
+{
+	EActionResult Result;
+	FActionFinishReason Reason;
+};
+
+/** Promise behind FAction::GetCompletion, an action released without finishing completes it with Abort. */
+struct FActionCompletion
 {
-	DECLARE_DELEGATE_RetVal_OneParam(bool, FPrerequisite, FAction*);
-	DECLARE_DELEGATE_OneParam(FPreExecute, FAction*);
-	DECLARE_DELEGATE_ThreeParams(FPostFinish, FAction*, EActionResult, const FString&);
+	~FActionCompletion();
+
+	TPromise<FActionOutcome> Promise;
+	TSharedFuture<FActionOutcome> Future;
+};
+
+/** Identifies the concrete class of an action, see DECLARE_ACTION_CLASS. */
+typedef const void* FActionClassId;
+
+/** Gives an action class its own FActionClassId, which unlike GetName a subclass cannot pass off as its parent's. */
+#define DECLARE_ACTION_CLASS() \
+	static FActionClassId StaticClassId() { static const uint8 ClassIdTag = 0; return &ClassIdTag; } \
+	virtual FActionClassId GetClassId() const override { return StaticClassId(); }
 
+class NEWPROJECT_API FAction : public TSharedFromThis<FAction>
+{
 	friend class UActionComponent;
+	friend class FActionSlotArray;
 	friend class FAction_Parallel;
 	friend class FAction_Sequence;
+	friend class FAction_Program;
+	friend class FAction_Repeat;
+	friend class FAction_Timeout;
+	friend class FAction_Retry;
+	friend class FAction_Script;
+	template<typename ActionType> friend class TActionPool;
 public:
 	FAction()
 		: ParentAction(nullptr)
@@ -28,16 +71,61 @@ public:
 
 	virtual ~FAction() {}
 
-	virtual float GetTimeRadio() const { return 0.0f; }
-
-	FPrerequisite Prerequisite;
-	FPreExecute PreExecute;
-	FPostFinish PostFinish;
+	static FActionClassId StaticClassId() { static const uint8 ClassIdTag = 0; return &ClassIdTag; }
+	virtual FActionClassId GetClassId() const { return StaticClassId(); }
 
-	virtual TArray<const FAction*> GetActiveActions() const { return { this }; }
+	virtual float GetTimeRadio() const { return 0.0f; }
 
-	FORCEINLINE bool IsType(EActionType InType) const { return TypeIsAType(Type, InType); }
-	FORCEINLINE EActionType GetType() const { return Type; }
+	/** Hooks to bind callbacks on, allocated on first use. Clones share them until one of them edits its own. */
+	FActionHooks& EditHooks();
+	FORCEINLINE const FActionHooks* GetHooks() const { return Hooks.Get(); }
+	FORCEINLINE bool HasBoundHooks() const { return Hooks.IsValid() && Hooks->IsAnyBound(); }
+	/** Nothing observes or configures this action beyond its parameters, the only kind of node a composite may dissolve into itself. */
+	FORCEINLINE bool IsPlain() const { return !HasBoundHooks() && !Completion.IsValid() && ActionPriority == 0 && QueueTimeout == 0.0f; }
+
+	/**
+	 * Future set when this action next finishes, including when it is rejected, times out in the queue or fails its prerequisite.
+	 * Nothing is allocated for actions nobody asked, copies made by CloneAction do not share it.
+	 */
+	TSharedFuture<FActionOutcome> GetCompletion();
+
+	/** Against conflicting running actions a higher priority preempts, an equal one follows the conflict matrix and a lower one waits. */
+	int32 ActionPriority = 0;
+	/** Seconds a waiting action stays queued before it fails with QueueTimeout, zero rejects it instead of queueing, negative waits forever. */
+	float QueueTimeout = 0.0f;
+
+	/** Calls Visitor on every leaf action currently running under this one until it returns false, returns false if stopped early. */
+	virtual bool ForEachActiveAction(TFunctionRef<bool(const FAction*)> Visitor) const { return Visitor(this); }
+	TArray<const FAction*> GetActiveActions() const;
+
+	/** Whether TickAction does real work, actions completed only by events return false so an idle component can stop ticking. */
+	virtual bool NeedsTick() const { return true; }
+
+	/** Called by TActionPool as soon as an instance is released, must restore the freshly constructed state and drop what it holds. */
+	virtual void ResetAction();
+
+	/** Makes a finished action ready to run again while keeping its parameters and hooks, composites rearm their children. */
+	virtual void RearmAction() {}
+
+	/** Keeps the actions of this subtree around once they finish so RearmAction can replay them, composites that rearm their child call it. */
+	virtual void RetainFinishedChildren() {}
+
+	/**
+	 * Copy of this action as it is now, composites copy their children as well. Cloning actions that have not run yet is what FActionPrototype relies on.
+	 * Every concrete action overrides it through its own pool, the base version only reports the missing override.
+	 */
+	virtual TSharedPtr<FAction> CloneAction() const;
+
+	FORCEINLINE bool IsType(EActionType InType) const { return TypeIsAType(GetType(), InType); }
+	/** Resolves a type marked dirty by NotifyTypeChanged, so only the subtrees that changed are recomputed. */
+	FORCEINLINE EActionType GetType() const
+	{
+		if (bTypeDirty)
+		{
+			ResolveType();
+		}
+		return Type;
+	}
 
 	static bool TypeIsAType(EActionType InType, EActionType IsType) { return ((InType & IsType) != EActionType::Default); }
 
@@ -47,10 +135,13 @@ public:
 	FORCEINLINE AActor* GetOwner() const { return Owner.IsValid() ? Owner.Get() : nullptr; }
 	FORCEINLINE UActionComponent* GetActionComponent() const { return ActionComponent.IsValid() ? ActionComponent.Get() : nullptr; }
 
+	/** Pawn, character, movement, mesh and anim instance of the owner as cached by the component, all null without one. */
+	const FActionOwnerContext& GetOwnerContext() const;
+
 protected:
 
 	virtual EActionResult ExecuteAction() { return EActionResult::Wait; }
-	virtual bool FinishAction(EActionResult InResult, const FString& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) { return true; }
+	virtual bool FinishAction(EActionResult InResult, const FActionFinishReason& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) { return true; }
 	virtual EActionResult TickAction(float DeltaTime) { return EActionResult::Wait; }
 
 	void SetOwner(AActor* InOwner);
@@ -59,19 +150,58 @@ protected:
 
 	TWeakPtr<FAction> ParentAction = nullptr;
 
-	void NotifyActionFinish(EActionResult Result, const FString& Reason = EActionFinishReason::UnKnown);
+	void NotifyActionFinish(EActionResult Result, const FActionFinishReason& Reason = EActionFinishReason::UnKnown);
+	/** Marks this action and its ancestors dirty, the types are recomputed when next read and the root is re-bucketed once per batch. */
 	void NotifyTypeChanged();
+	/** The component's clock, zero without a component. */
+	float GetActionTime() const;
+
+	/** Wakes the component's tick after NeedsTick turned true outside of ExecuteAction. */
+	void RequestTick();
+	/** Drops the component's cached leaf list, NotifyTypeChanged calls it since composites notify whenever their running children change. */
+	void NotifyActiveActionsChanged();
 	virtual void UpdateType() {}
 
-	virtual bool FinishChildAction(FAction* InAction, EActionResult InResult, const FString& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) { return true; }
+	virtual bool FinishChildAction(FAction* InAction, EActionResult InResult, const FActionFinishReason& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) { return true; }
 
 	EActionType Type;
 
 private:
-	bool DoFinishAction(EActionResult InResult, const FString& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default);
+	/** Clears what a copy must not share with its source: tree links, slot and owner. */
+	void DetachCopy();
+
+	void ResolveType() const;
+
+	FORCEINLINE void ExecutePostFinish(EActionResult InResult, const FActionFinishReason& Reason)
+	{
+		if (Hooks.IsValid())
+		{
+			Hooks->PostFinish.ExecuteIfBound(this, InResult, Reason);
+		}
+		if (Completion.IsValid())
+		{
+			Complete(InResult, Reason);
+		}
+	}
+
+	void Complete(EActionResult InResult, const FActionFinishReason& Reason);
+
+	bool DoFinishAction(EActionResult InResult, const FActionFinishReason& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default);
 	EActionResult DoExecuteAction();
 	EActionResult DoTickAction(float DeltaTime);
 
+	TSharedPtr<FActionHooks> Hooks;
+	TSharedPtr<FActionCompletion> Completion;
+
 	TWeakObjectPtr<AActor> Owner;
 	TWeakObjectPtr<UActionComponent> ActionComponent;
+
+	/** Slot of a root action in its component's FActionSlotArray, INDEX_NONE for children and finished actions. */
+	int32 SlotIndex = INDEX_NONE;
+
+	/** Position among the children of a composite that looks its children up by index. */
+	int32 IndexInParent = INDEX_NONE;
+
+	/** Set until UpdateType has run since the last NotifyTypeChanged, a dirty action's ancestors that read its type are dirty too. */
+	bool bTypeDirty = false;
 };
@@ -0,0 +1,472 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/CollisionProfile.h"
+#include "Components/StaticMeshComponent.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "ActionComponent.h"
+#include "ActionComponentSettings.h"
+#include "Action_ServerMoveTo.h"
+#include "Action_Wait.h"
+#include "Action_Sequence.h"
+#include "Action_Parallel.h"
+#include "Action_Program.h"
+#include "Action_Script.h"
+
+namespace ActionBenchmarks
+{
+	static const uint32 TestFlags = EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter;
+
+	/** Game world with no map, torn down with this object. */
+	struct FTransientWorld
+	{
+		UWorld* World = nullptr;
+
+		FTransientWorld()
+		{
+			World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("ActionBenchmarkWorld"));
+			FWorldContext& Context = GEngine->CreateNewWorldContext(EWorldType::Game);
+			Context.SetCurrentWorld(World);
+			World->InitializeActorsForPlay(FURL());
+			World->BeginPlay();
+		}
+
+		~FTransientWorld()
+		{
+			GEngine->DestroyWorldContext(World);
+			World->DestroyWorld(false);
+		}
+
+		/** Returns the average milliseconds of a frame. */
+		double Tick(int32 NumFrames, float DeltaTime = 1.0f / 30.0f)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+			{
+				World->Tick(LEVELTICK_All, DeltaTime);
+			}
+			return (FPlatformTime::Seconds() - StartTime) * 1000.0 / FMath::Max(NumFrames, 1);
+		}
+
+		/** A blocking engine cube scaled to Size and centred at Location. */
+		AStaticMeshActor* SpawnBox(const FVector& Location, const FVector& Size)
+		{
+			static UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+			AStaticMeshActor* Box = World->SpawnActor<AStaticMeshActor>(Location, FRotator::ZeroRotator);
+			UStaticMeshComponent* Mesh = Box->GetStaticMeshComponent();
+			Mesh->SetMobility(EComponentMobility::Movable);
+			Mesh->SetStaticMesh(Cube);
+			Mesh->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+			Box->SetActorScale3D(Size / 100.0f);
+			return Box;
+		}
+
+		/** Action component on an otherwise empty actor, for benchmarks that need an owner but no movement. */
+		UActionComponent* SpawnComponent()
+		{
+			AActor* Actor = World->SpawnActor<AActor>();
+			UActionComponent* Component = NewObject<UActionComponent>(Actor);
+			Component->RegisterComponent();
+			return Component;
+		}
+
+		UActionComponent* SpawnAgent(const FVector& FeetLocation)
+		{
+			FActorSpawnParameters Params;
+			Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+			ACharacter* Character = World->SpawnActor<ACharacter>(FeetLocation + FVector(0.0f, 0.0f, 90.0f), FRotator::ZeroRotator, Params);
+			Character->GetCharacterMovement()->SetMovementMode(MOVE_Walking);
+			UActionComponent* Component = NewObject<UActionComponent>(Character);
+			Component->RegisterComponent();
+			return Component;
+		}
+	};
+
+	/** Sets a console variable for the scope of the benchmark. */
+	struct FScopedCVar
+	{
+		IConsoleVariable* Variable;
+		FString PreviousValue;
+
+		FScopedCVar(const TCHAR* Name, int32 Value)
+			: Variable(IConsoleManager::Get().FindConsoleVariable(Name))
+		{
+			if (Variable)
+			{
+				PreviousValue = Variable->GetString();
+				Variable->Set(Value);
+			}
+		}
+
+		~FScopedCVar()
+		{
+			if (Variable)
+			{
+				Variable->Set(*PreviousValue);
+			}
+		}
+	};
+}
+
+/**
+ * Server-driven movers crossing a flat floor and a flight of steps, with every floor check synchronous, then with the floor
+ * cache alone and then with the cache and async sweeps. The cached cost per agent should fall as the crowd grows, and every
+ * agent must end at the height the synchronous run put it at, on the floor or on top of the step under it.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActionFloorCheckBenchmark, "ActionComponent.Benchmarks.FloorChecks", ActionBenchmarks::TestFlags)
+
+bool FActionFloorCheckBenchmark::RunTest(const FString& Parameters)
+{
+	UActionComponentSettings* Settings = GetMutableDefault<UActionComponentSettings>();
+	const float SavedCacheScale = Settings->FloorCacheRadiusScale;
+	const float SavedFarDistance = Settings->FarFloorCheckDistance;
+
+	struct FFloorMode
+	{
+		const TCHAR* Name;
+		bool bCache;
+		bool bAsync;
+	};
+	const FFloorMode Modes[] = { { TEXT("synchronous "), false, false }, { TEXT("cache only  "), true, false }, { TEXT("cache+async "), true, true } };
+	const int32 AgentCounts[] = { 64, 256, 1024 };
+	const float StepZTolerance = 2.0f;
+
+	// Final feet height of every agent in the synchronous run, per crowd size.
+	TMap<int32, TArray<float>> SyncFeetZ;
+	for (const FFloorMode& Mode : Modes)
+	{
+		Settings->FloorCacheRadiusScale = Mode.bCache ? SavedCacheScale : 0.0f;
+		Settings->FarFloorCheckDistance = 0.0f;
+		ActionBenchmarks::FScopedCVar AsyncFloorTraces(TEXT("ActionComponent.AsyncFloorTraces"), Mode.bAsync ? 1 : 0);
+
+		for (int32 NumAgents : AgentCounts)
+		{
+			ActionBenchmarks::FTransientWorld Benchmark;
+
+			// Half the lanes cross a flat floor, the other half climb 20cm steps. Agents queue up behind X = 0 so none starts inside a step.
+			const int32 NumLanes = FMath::CeilToInt(FMath::Sqrt((float)NumAgents));
+			const float LaneWidth = 120.0f;
+			const float LaneLength = 2000.0f;
+			const float RowSpacing = 60.0f;
+			const float QueueLength = NumAgents / NumLanes * RowSpacing;
+			const float StepsStartX = 400.0f;
+			const float StepLength = 200.0f;
+			const int32 NumSteps = 8;
+			Benchmark.SpawnBox(FVector((LaneLength - QueueLength) * 0.5f, NumLanes * LaneWidth * 0.5f, -50.0f), FVector(LaneLength + QueueLength + 400.0f, NumLanes * LaneWidth + 400.0f, 100.0f));
+			for (int32 Step = 0; Step < NumSteps; ++Step)
+			{
+				const float StepHeight = 20.0f * (Step + 1);
+				Benchmark.SpawnBox(FVector(StepsStartX + Step * StepLength + StepLength * 0.5f, NumLanes * LaneWidth * 0.75f, StepHeight * 0.5f), FVector(StepLength, NumLanes * LaneWidth * 0.5f, StepHeight));
+			}
+
+			TArray<ACharacter*> Characters;
+			for (int32 Index = 0; Index < NumAgents; ++Index)
+			{
+				const float Lane = (Index % NumLanes) * LaneWidth + LaneWidth * 0.5f;
+				const float Row = -(Index / NumLanes) * RowSpacing;
+				UActionComponent* Agent = Benchmark.SpawnAgent(FVector(Row, Lane, 0.0f));
+				Agent->ExecuteAction(FAction_ServerMoveTo::CreateAction(FVector(LaneLength, Lane, 0.0f), 300.0f));
+				Characters.Add(CastChecked<ACharacter>(Agent->GetOwner()));
+			}
+
+			Benchmark.Tick(10);
+			const double FrameMs = Benchmark.Tick(60);
+			AddInfo(FString::Printf(TEXT("%s, %4d agents: %7.3f ms/frame, %6.2f us/agent"), Mode.Name, NumAgents, FrameMs, FrameMs * 1000.0 / NumAgents));
+
+			TArray<float>& ExpectedFeetZ = SyncFeetZ.FindOrAdd(NumAgents);
+			int32 NumOffFloor = 0;
+			int32 NumDiverged = 0;
+			for (int32 Index = 0; Index < Characters.Num(); ++Index)
+			{
+				const ACharacter* Character = Characters[Index];
+				const UCapsuleComponent* Capsule = Character->GetCapsuleComponent();
+				const FVector Location = Character->GetActorLocation();
+				const float FeetZ = Location.Z - Capsule->GetScaledCapsuleHalfHeight();
+
+				// Clear of a step edge, the feet must rest on the floor or on the top of the step below them.
+				const bool bSteppedLane = Location.Y > NumLanes * LaneWidth * 0.5f;
+				const float StepOffset = Location.X - StepsStartX;
+				const int32 Step = FMath::FloorToInt(StepOffset / StepLength);
+				const float EdgeDistance = FMath::Min(StepOffset - Step * StepLength, (Step + 1) * StepLength - StepOffset);
+				if (EdgeDistance > Capsule->GetScaledCapsuleRadius() || StepOffset < -Capsule->GetScaledCapsuleRadius())
+				{
+					const float FloorZ = bSteppedLane && Step >= 0 && Step < NumSteps ? 20.0f * (Step + 1) : 0.0f;
+					NumOffFloor += FMath::Abs(FeetZ - FloorZ) > StepZTolerance ? 1 : 0;
+				}
+
+				if (!Mode.bCache)
+				{
+					ExpectedFeetZ.Add(FeetZ);
+				}
+				else if (ExpectedFeetZ.IsValidIndex(Index))
+				{
+					NumDiverged += FMath::Abs(FeetZ - ExpectedFeetZ[Index]) > StepZTolerance ? 1 : 0;
+				}
+			}
+			TestEqual(FString::Printf(TEXT("%s, %d agents: agents off the floor"), Mode.Name, NumAgents), NumOffFloor, 0);
+			TestEqual(FString::Printf(TEXT("%s, %d agents: agents away from the synchronous height"), Mode.Name, NumAgents), NumDiverged, 0);
+		}
+	}
+
+	Settings->FloorCacheRadiusScale = SavedCacheScale;
+	Settings->FarFloorCheckDistance = SavedFarDistance;
+	return true;
+}
+
+namespace ActionBenchmarks
+{
+	DECLARE_DELEGATE_RetVal_OneParam(bool, FDelegatePrerequisite, FAction*);
+	DECLARE_DELEGATE_OneParam(FDelegatePreExecute, FAction*);
+	DECLARE_DELEGATE_ThreeParams(FDelegatePostFinish, FAction*, EActionResult, const FActionFinishReason&);
+
+	/** A patrol loop stand-in: legs that wait on two timers at once followed by a pause, about four seconds in all. */
+	TSharedPtr<FAction> CreatePatrol()
+	{
+		TArray<TSharedPtr<FAction>> Legs;
+		for (int32 Leg = 0; Leg < 8; ++Leg)
+		{
+			Legs.Add(FAction_Parallel::CreateAction({ FAction_Wait::CreateAction(0.3f), FAction_Wait::CreateAction(0.4f) }));
+			Legs.Add(FAction_Wait::CreateAction(0.1f));
+		}
+		return FAction_Sequence::CreateAction(Legs);
+	}
+
+	/** The three delegates FAction held inline before they moved to FActionHooks. */
+	struct FDelegateHooks
+	{
+		FDelegatePrerequisite Prerequisite;
+		FDelegatePreExecute PreExecute;
+		FDelegatePostFinish PostFinish;
+	};
+}
+
+/** Size of an action with the hook table against inline delegates, then the cost of a call and of an execute and finish. */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActionCallbackBenchmark, "ActionComponent.Benchmarks.Callbacks", ActionBenchmarks::TestFlags)
+
+bool FActionCallbackBenchmark::RunTest(const FString& Parameters)
+{
+	const SIZE_T HookTableSize = sizeof(TSharedPtr<FActionHooks>);
+	AddInfo(FString::Printf(TEXT("sizeof(FAction): %d with the hook table, %d with inline delegates"),
+		(int32)sizeof(FAction), (int32)(sizeof(FAction) - HookTableSize + sizeof(ActionBenchmarks::FDelegateHooks))));
+	AddInfo(FString::Printf(TEXT("sizeof(FActionHooks): %d, one TActionCallback: %d, one TDelegate: %d"),
+		(int32)sizeof(FActionHooks), (int32)sizeof(TActionCallback<bool(FAction*)>), (int32)sizeof(ActionBenchmarks::FDelegatePrerequisite)));
+
+	const int32 NumCalls = 1000000;
+	int32 Counter = 0;
+	{
+		TActionCallback<bool(FAction*)> Callback;
+		Callback.BindLambda([&Counter](FAction*) { return ++Counter > 0; });
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < NumCalls; ++Index)
+		{
+			Callback.Execute(nullptr);
+		}
+		AddInfo(FString::Printf(TEXT("TActionCallback call: %.2f ns"), (FPlatformTime::Seconds() - StartTime) * 1e9 / NumCalls));
+	}
+	{
+		ActionBenchmarks::FDelegatePrerequisite Delegate;
+		Delegate.BindLambda([&Counter](FAction*) { return ++Counter > 0; });
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < NumCalls; ++Index)
+		{
+			Delegate.Execute(nullptr);
+		}
+		AddInfo(FString::Printf(TEXT("TDelegate call: %.2f ns"), (FPlatformTime::Seconds() - StartTime) * 1e9 / NumCalls));
+	}
+
+	ActionBenchmarks::FTransientWorld Benchmark;
+	UActionComponent* Component = Benchmark.SpawnComponent();
+	const int32 NumActions = 100000;
+	const bool HookModes[] = { false, true };
+	for (const bool bHooks : HookModes)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < NumActions; ++Index)
+		{
+			TSharedPtr<FAction_Wait> Action = FAction_Wait::CreateAction(0.0f);
+			if (bHooks)
+			{
+				FActionHooks& Hooks = Action->EditHooks();
+				Hooks.PreExecute.BindLambda([&Counter](FAction*) { ++Counter; });
+				Hooks.PostFinish.BindLambda([&Counter](FAction*, EActionResult, const FActionFinishReason&) { ++Counter; });
+			}
+			Component->ExecuteAction(Action);
+		}
+		AddInfo(FString::Printf(TEXT("Instant execute and finish, %s: %.2f ns"),
+			bHooks ? TEXT("two hooks bound") : TEXT("no hooks"), (FPlatformTime::Seconds() - StartTime) * 1e9 / NumActions));
+	}
+	return Counter > 0;
+}
+
+/** Components each running one waiting action, ticked by their own tick functions and then by the world's tick manager. */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActionTickManagerBenchmark, "ActionComponent.Benchmarks.TickManager", ActionBenchmarks::TestFlags)
+
+bool FActionTickManagerBenchmark::RunTest(const FString& Parameters)
+{
+	const int32 ComponentCounts[] = { 100, 1000, 10000 };
+	const bool BatchModes[] = { false, true };
+	for (const bool bBatched : BatchModes)
+	{
+		ActionBenchmarks::FScopedCVar BatchedTick(TEXT("ActionComponent.BatchedTick"), bBatched ? 1 : 0);
+		for (int32 NumComponents : ComponentCounts)
+		{
+			ActionBenchmarks::FTransientWorld Benchmark;
+			for (int32 Index = 0; Index < NumComponents; ++Index)
+			{
+				Benchmark.SpawnComponent()->ExecuteAction(FAction_Wait::CreateAction(1000.0f));
+			}
+
+			Benchmark.Tick(10);
+			const double FrameMs = Benchmark.Tick(100);
+			AddInfo(FString::Printf(TEXT("%s, %5d components: %7.3f ms/frame, %6.3f us/component"),
+				bBatched ? TEXT("batched      ") : TEXT("per-component"), NumComponents, FrameMs, FrameMs * 1000.0 / NumComponents));
+		}
+	}
+	return true;
+}
+
+/** Sequences of instant steps as long as scripted cutscene ones, the cost per step should not grow with the length. */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActionSequenceBenchmark, "ActionComponent.Benchmarks.LongSequences", ActionBenchmarks::TestFlags)
+
+bool FActionSequenceBenchmark::RunTest(const FString& Parameters)
+{
+	ActionBenchmarks::FTransientWorld Benchmark;
+	UActionComponent* Component = Benchmark.SpawnComponent();
+
+	const int32 SequenceLengths[] = { 50, 100, 200 };
+	const int32 NumRuns = 1000;
+	for (int32 NumSteps : SequenceLengths)
+	{
+		double Seconds = 0.0;
+		for (int32 Run = 0; Run < NumRuns; ++Run)
+		{
+			TArray<TSharedPtr<FAction>> Steps;
+			for (int32 Step = 0; Step < NumSteps; ++Step)
+			{
+				Steps.Add(FAction_Wait::CreateAction(0.0f));
+			}
+			TSharedPtr<FAction_Sequence> Sequence = FAction_Sequence::CreateAction(Steps);
+
+			const double StartTime = FPlatformTime::Seconds();
+			Component->ExecuteAction(Sequence);
+			Seconds += FPlatformTime::Seconds() - StartTime;
+		}
+		AddInfo(FString::Printf(TEXT("%3d steps: %8.2f us/sequence, %6.1f ns/step"), NumSteps, Seconds * 1e6 / NumRuns, Seconds * 1e9 / (NumRuns * NumSteps)));
+	}
+	return true;
+}
+
+/** 10000 agents running the same patrol, as a tree of sequences and parallels and compiled into an FAction_Program. */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActionProgramBenchmark, "ActionComponent.Benchmarks.ProgramVsTree", ActionBenchmarks::TestFlags)
+
+bool FActionProgramBenchmark::RunTest(const FString& Parameters)
+{
+	const int32 NumAgents = 10000;
+	const bool CompileModes[] = { false, true };
+	for (const bool bCompiled : CompileModes)
+	{
+		ActionBenchmarks::FTransientWorld Benchmark;
+		TArray<UActionComponent*> Agents;
+		for (int32 Index = 0; Index < NumAgents; ++Index)
+		{
+			Agents.Add(Benchmark.SpawnComponent());
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (UActionComponent* Agent : Agents)
+		{
+			TSharedPtr<FAction> Patrol = ActionBenchmarks::CreatePatrol();
+			Agent->ExecuteAction(bCompiled ? FAction_Program::Compile(Patrol) : Patrol);
+		}
+		const double StartMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		// Long enough for every leg to finish at least once.
+		const double FrameMs = Benchmark.Tick(120);
+		AddInfo(FString::Printf(TEXT("%s: start %8.2f ms, %7.3f ms/frame"), bCompiled ? TEXT("program") : TEXT("tree   "), StartMs, FrameMs));
+	}
+	return true;
+}
+
+/** Five awaited steps written as an FAction_Script against the equivalent FAction_Sequence, instant and then ticked. */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActionScriptBenchmark, "ActionComponent.Benchmarks.ScriptVsSequence", ActionBenchmarks::TestFlags)
+
+bool FActionScriptBenchmark::RunTest(const FString& Parameters)
+{
+	ActionBenchmarks::FTransientWorld Benchmark;
+	UActionComponent* Component = Benchmark.SpawnComponent();
+
+	const int32 NumRuns = 100000;
+	const bool ScriptModes[] = { false, true };
+	for (const bool bScript : ScriptModes)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Run = 0; Run < NumRuns; ++Run)
+		{
+			if (bScript)
+			{
+				Component->ExecuteAction(FAction_Script::CreateAction([](FActionScriptContext& Ctx) -> EActionResult
+				{
+					ACTION_SCRIPT_BEGIN(Ctx);
+					ACTION_AWAIT(Ctx, FAction_Wait::CreateAction(0.0f));
+					ACTION_AWAIT(Ctx, FAction_Wait::CreateAction(0.0f));
+					ACTION_AWAIT(Ctx, FAction_Wait::CreateAction(0.0f));
+					ACTION_AWAIT(Ctx, FAction_Wait::CreateAction(0.0f));
+					ACTION_AWAIT(Ctx, FAction_Wait::CreateAction(0.0f));
+					ACTION_SCRIPT_END(Ctx);
+				}));
+			}
+			else
+			{
+				Component->ExecuteAction(FAction_Sequence::CreateAction({ FAction_Wait::CreateAction(0.0f), FAction_Wait::CreateAction(0.0f),
+					FAction_Wait::CreateAction(0.0f), FAction_Wait::CreateAction(0.0f), FAction_Wait::CreateAction(0.0f) }));
+			}
+		}
+		AddInfo(FString::Printf(TEXT("%s, 5 instant steps: %.2f us/run"), bScript ? TEXT("script  ") : TEXT("sequence"), (FPlatformTime::Seconds() - StartTime) * 1e6 / NumRuns));
+	}
+
+	// Ticked steps: many components each awaiting short waits, so the cost of resuming from a completion shows.
+	const int32 NumAgents = 1000;
+	for (const bool bScript : ScriptModes)
+	{
+		ActionBenchmarks::FTransientWorld TickedBenchmark;
+		for (int32 Index = 0; Index < NumAgents; ++Index)
+		{
+			UActionComponent* Agent = TickedBenchmark.SpawnComponent();
+			if (bScript)
+			{
+				Agent->ExecuteAction(FAction_Script::CreateAction([](FActionScriptContext& Ctx) -> EActionResult
+				{
+					ACTION_SCRIPT_BEGIN(Ctx);
+					ACTION_AWAIT(Ctx, FAction_Wait::CreateAction(0.1f));
+					ACTION_AWAIT(Ctx, FAction_Wait::CreateAction(0.1f));
+					ACTION_AWAIT(Ctx, FAction_Wait::CreateAction(0.1f));
+					ACTION_AWAIT(Ctx, FAction_Wait::CreateAction(0.1f));
+					ACTION_AWAIT(Ctx, FAction_Wait::CreateAction(0.1f));
+					ACTION_SCRIPT_END(Ctx);
+				}));
+			}
+			else
+			{
+				Agent->ExecuteAction(FAction_Sequence::CreateAction({ FAction_Wait::CreateAction(0.1f), FAction_Wait::CreateAction(0.1f),
+					FAction_Wait::CreateAction(0.1f), FAction_Wait::CreateAction(0.1f), FAction_Wait::CreateAction(0.1f) }));
+			}
+		}
+		const double FrameMs = TickedBenchmark.Tick(20);
+		AddInfo(FString::Printf(TEXT("%s, %d agents with 0.1s steps: %7.3f ms/frame"), bScript ? TEXT("script  ") : TEXT("sequence"), NumAgents, FrameMs));
+	}
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
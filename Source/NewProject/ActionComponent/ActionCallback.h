@@ -0,0 +1,173 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+template<typename FuncType>
+class TActionCallback;
+
+/**
+ * Single-cast callback with small-buffer storage, what FAction uses in place of TDelegate.
+ * Callables up to InlineSize bytes, lambdas with a few captures and bound methods included, are stored inline,
+ * larger ones are heap allocated. Calling goes through one function pointer.
+ */
+template<typename RetType, typename... ArgTypes>
+class TActionCallback<RetType(ArgTypes...)>
+{
+public:
+	static const int32 InlineSize = 32;
+
+	TActionCallback() {}
+	TActionCallback(const TActionCallback& Other) { CopyFrom(Other); }
+	~TActionCallback() { Unbind(); }
+
+	TActionCallback& operator=(const TActionCallback& Other)
+	{
+		if (this != &Other)
+		{
+			Unbind();
+			CopyFrom(Other);
+		}
+		return *this;
+	}
+
+	template<typename FunctorType>
+	void BindLambda(FunctorType&& Functor)
+	{
+		typedef typename TDecay<FunctorType>::Type FStoredType;
+		static const bool bInline = sizeof(FStoredType) <= InlineSize && alignof(FStoredType) <= 16;
+
+		Unbind();
+		if (bInline)
+		{
+			new (&Storage) FStoredType(Forward<FunctorType>(Functor));
+		}
+		else
+		{
+			*(FStoredType**)&Storage = new FStoredType(Forward<FunctorType>(Functor));
+		}
+		Ops = TOps<FStoredType, bInline>::GetTable();
+	}
+
+	template<typename UserClass, typename MethodType>
+	void BindRaw(UserClass* InUserObject, MethodType InMethod)
+	{
+		BindLambda([InUserObject, InMethod](ArgTypes... Args) -> RetType
+		{
+			return (InUserObject->*InMethod)(Args...);
+		});
+	}
+
+	/** Calls nothing and returns a default value once InUserObject has been destroyed. */
+	template<typename UserClass, typename MethodType>
+	void BindUObject(UserClass* InUserObject, MethodType InMethod)
+	{
+		TWeakObjectPtr<UserClass> WeakObject(InUserObject);
+		BindLambda([WeakObject, InMethod](ArgTypes... Args) -> RetType
+		{
+			UserClass* UserObject = WeakObject.Get();
+			return UserObject ? (UserObject->*InMethod)(Args...) : RetType();
+		});
+	}
+
+	/** Calls nothing and returns a default value once InUserObject has been released. */
+	template<typename UserClass, typename MethodType>
+	void BindSP(const TSharedRef<UserClass>& InUserObject, MethodType InMethod)
+	{
+		TWeakPtr<UserClass> WeakObject(InUserObject);
+		BindLambda([WeakObject, InMethod](ArgTypes... Args) -> RetType
+		{
+			TSharedPtr<UserClass> UserObject = WeakObject.Pin();
+			return UserObject.IsValid() ? (UserObject.Get()->*InMethod)(Args...) : RetType();
+		});
+	}
+
+	void Unbind()
+	{
+		if (Ops)
+		{
+			Ops->Destroy(&Storage);
+			Ops = nullptr;
+		}
+	}
+
+	FORCEINLINE bool IsBound() const { return Ops != nullptr; }
+
+	FORCEINLINE RetType Execute(ArgTypes... Args) const
+	{
+		check(Ops);
+		return Ops->Call(&Storage, Args...);
+	}
+
+	/** Returns whether the callback was bound, any return value is dropped. */
+	FORCEINLINE bool ExecuteIfBound(ArgTypes... Args) const
+	{
+		if (!Ops)
+			return false;
+		Ops->Call(&Storage, Args...);
+		return true;
+	}
+
+private:
+	struct FOps
+	{
+		RetType (*Call)(void* Storage, ArgTypes... Args);
+		void (*Copy)(void* Dest, const void* Source);
+		void (*Destroy)(void* Storage);
+	};
+
+	template<typename FunctorType, bool bInline>
+	struct TOps
+	{
+		static FunctorType* Get(void* Storage) { return bInline ? (FunctorType*)Storage : *(FunctorType**)Storage; }
+		static const FunctorType* Get(const void* Storage) { return bInline ? (const FunctorType*)Storage : *(FunctorType* const*)Storage; }
+
+		static RetType Call(void* Storage, ArgTypes... Args)
+		{
+			return (*Get(Storage))(Args...);
+		}
+
+		static void Copy(void* Dest, const void* Source)
+		{
+			if (bInline)
+			{
+				new (Dest) FunctorType(*Get(Source));
+			}
+			else
+			{
+				*(FunctorType**)Dest = new FunctorType(*Get(Source));
+			}
+		}
+
+		static void Destroy(void* Storage)
+		{
+			if (bInline)
+			{
+				Get(Storage)->~FunctorType();
+			}
+			else
+			{
+				delete Get(Storage);
+			}
+		}
+
+		static const FOps* GetTable()
+		{
+			static const FOps Table = { &Call, &Copy, &Destroy };
+			return &Table;
+		}
+	};
+
+	void CopyFrom(const TActionCallback& Other)
+	{
+		if (Other.Ops)
+		{
+			Other.Ops->Copy(&Storage, &Other.Storage);
+			Ops = Other.Ops;
+		}
+	}
+
+	mutable TAlignedBytes<InlineSize, 16> Storage;
+	const FOps* Ops = nullptr;
+};
@@ -4,12 +4,23 @@
 #include "VisualLogger/VisualLogger.h"
 #include "VisualLogger/VisualLoggerTypes.h"
 #include "Action.h"
+#include "ActionTickManager.h"
+#include "ActionComponentSettings.h"
+#include "ActionStats.h"
+#include "Engine/World.h"
 #include "GameFramework/Controller.h"
 #include "GameFramework/Pawn.h"
 #include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Components/SkeletalMeshComponent.h"
 
 DEFINE_LOG_CATEGORY(LogActionComponent)
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Preemptions Avoided"), STAT_ActionPreemptionsAvoided, STATGROUP_ActionComponent);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Active Leaf Rebuilds"), STAT_ActionActiveLeafRebuilds, STATGROUP_ActionComponent);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Type Re-buckets"), STAT_ActionTypeRebuckets, STATGROUP_ActionComponent);
+DECLARE_CYCLE_STAT(TEXT("Resolve Action Types"), STAT_ActionResolveTypes, STATGROUP_ActionComponent);
+
 UActionComponent::UActionComponent(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	PrimaryComponentTick.bCanEverTick = true;
@@ -18,64 +29,162 @@ UActionComponent::UActionComponent(const FObjectInitializer& ObjectInitializer)
 	bWantsInitializeComponent = true;
 }
 
-void UActionComponent::StopMoveAction(const FString& Reason /*= EActionFinishReason::CustomStop*/)
+void UActionComponent::StopMoveAction(const FActionFinishReason& Reason /*= EActionFinishReason::CustomStop*/)
 {
 	StopActionsByType(EActionType::Move, true, Reason);
 }
 
-void UActionComponent::StopAction(FAction *InAction, const FString& Reason /*= EActionFinishReason::CustomStop*/)
+void UActionComponent::StopAction(FAction *InAction, const FActionFinishReason& Reason /*= EActionFinishReason::CustomStop*/)
 {
 	FinishAction(InAction, EActionResult::Abort, Reason);
 }
 
-void UActionComponent::StopActionsByType(EActionType InType, bool bForce /*= true*/, const FString& Reason /*= EActionFinishReason::CustomStop*/)
+void UActionComponent::StopAction(const FActionHandle& Handle, const FActionFinishReason& Reason /*= EActionFinishReason::CustomStop*/)
 {
-	TMap<EActionType, TArray<TSharedPtr<FAction>>> TempActions = Actions;
-	for (auto Pair : TempActions)
+	const int32 Index = Actions.Resolve(Handle);
+	if (Actions.IsOccupied(Index))
 	{
-		EActionType IsType = Pair.Key;
-		EActionType LType = InType;
-		EActionType RType = IsType;
-		if (bForce == false)
-		{
-			LType &= (EActionType)(~(uint32)(EActionType::Animation));
-			RType &= (EActionType)(~(uint32)(EActionType::Animation));
-		}
-		if (FAction::TypeIsAType(LType, RType))
+		FinishAction(Actions[Index].Action.Get(), EActionResult::Abort, Reason);
+	}
+	else
+	{
+		Actions.CancelReservation(Index);
+	}
+}
+
+void UActionComponent::StopActionsByType(EActionType InType, bool bForce /*= true*/, const FActionFinishReason& Reason /*= EActionFinishReason::CustomStop*/)
+{
+	if (bIsTickingActions)
+	{
+		FActionCommand& Command = PendingCommands[PendingCommands.AddDefaulted()];
+		Command.Command = EActionCommand::StopByType;
+		Command.Type = InType;
+		Command.bForce = bForce;
+		Command.Reason = Reason;
+		return;
+	}
+
+	ResolveActionTypes();
+	EActionType LType = InType;
+	if (bForce == false)
+	{
+		LType = UActionComponentSettings::GetConflictMatrix().GetPreemptedTypes(InType);
+	}
+	AbortActionsInChannels(LType, InType, Reason);
+	StartQueuedActions();
+}
+
+void UActionComponent::AbortActionsInChannels(EActionType InChannels, EActionType StopType, const FActionFinishReason& Reason)
+{
+	if (!Actions.ContainsType(InChannels))
+		return;
+
+	TArray<uint32, TInlineAllocator<4>> Words;
+	Actions.GetSlotsOfType(InChannels, Words);
+	for (int32 Word = 0; Word < Words.Num(); ++Word)
+	{
+		for (uint32 Bits = Words[Word]; Bits != 0; Bits &= Bits - 1)
 		{
-			Actions[IsType].Reset();
-			for (auto Action : Pair.Value)
+			const int32 Index = Word * 32 + FMath::CountTrailingZeros(Bits);
+			TSharedPtr<FAction> Action = Actions.RemoveAt(Index);
+			if (Action.IsValid())
 			{
-				if (Action.IsValid())
+				if (Action->DoFinishAction(EActionResult::Abort, Reason, StopType) == false)
 				{
-					if (Action->DoFinishAction(EActionResult::Abort, Reason, InType) == false)
-					{
-						if (!Actions.Contains(Action->GetType()))
-						{
-							Actions.Add(Action->GetType(), TArray<TSharedPtr<FAction>>());
-						}
-						Actions[Action->GetType()].Add(Action);
-					}
+					Actions.Add(Action, Action->GetType(), Index);
 				}
+				NotifySlotChanged(Index);
 			}
 		}
 	}
+}
+
+EActionConflictPolicy UActionComponent::ResolveConflict(const FAction* InAction, EActionType& OutPreemptedTypes) const
+{
+	const FActionConflictMatrix& ConflictMatrix = UActionComponentSettings::GetConflictMatrix();
+	const EActionType PreemptedTypes = ConflictMatrix.GetPreemptedTypes(InAction->GetType());
+	const EActionType QueuingTypes = ConflictMatrix.GetQueuingTypes(InAction->GetType());
+	OutPreemptedTypes = EActionType::Default;
+
+	if (!Actions.ContainsType(PreemptedTypes | QueuingTypes))
+		return EActionConflictPolicy::Coexist;
+
+	const int32 HighestPriority = GetHighestPriority(PreemptedTypes | QueuingTypes);
+	if (InAction->ActionPriority > HighestPriority)
+	{
+		OutPreemptedTypes = PreemptedTypes | QueuingTypes;
+		return EActionConflictPolicy::Preempt;
+	}
+	if (InAction->ActionPriority < HighestPriority || Actions.ContainsType(QueuingTypes))
+		return EActionConflictPolicy::Queue;
 
+	OutPreemptedTypes = PreemptedTypes;
+	return EActionConflictPolicy::Preempt;
 }
 
-bool UActionComponent::IsContainType(EActionType InType)
+int32 UActionComponent::GetHighestPriority(EActionType InType) const
 {
-	for (auto Pair : Actions)
+	int32 HighestPriority = MIN_int32;
+	TArray<uint32, TInlineAllocator<4>> Words;
+	Actions.GetSlotsOfType(InType, Words);
+	for (int32 Word = 0; Word < Words.Num(); ++Word)
 	{
-		if (Pair.Value.Num() > 0)
+		for (uint32 Bits = Words[Word]; Bits != 0; Bits &= Bits - 1)
 		{
-			if (FAction::TypeIsAType(Pair.Key, InType))
+			const FActionSlot& Slot = Actions[Word * 32 + FMath::CountTrailingZeros(Bits)];
+			if (!Slot.bPendingFinish)
 			{
-				return true;
+				HighestPriority = FMath::Max(HighestPriority, Slot.Action->ActionPriority);
 			}
 		}
 	}
-	return false;
+	return HighestPriority;
+}
+
+const TArray<const FAction*>& UActionComponent::GetActiveLeafActions()
+{
+	if (bActiveLeafActionsDirty || ActiveLeafActionsRevision != Actions.GetRevision())
+	{
+		INC_DWORD_STAT(STAT_ActionActiveLeafRebuilds);
+		ActiveLeafActions.Reset();
+		for (const FActionSlot& Slot : Actions)
+		{
+			Slot.Action->ForEachActiveAction([this](const FAction* Leaf) { ActiveLeafActions.Add(Leaf); return true; });
+		}
+		ActiveLeafActionsRevision = Actions.GetRevision();
+		bActiveLeafActionsDirty = false;
+	}
+	return ActiveLeafActions;
+}
+
+float UActionComponent::GetActionTime() const
+{
+	const UWorld* World = GetWorld();
+	return World ? World->GetTimeSeconds() : 0.0f;
+}
+
+bool UActionComponent::IsContainType(EActionType InType)
+{
+	ResolveActionTypes();
+	return Actions.ContainsType(InType);
+}
+
+bool UActionComponent::IsRunning(const FActionHandle& Handle) const
+{
+	const int32 Index = Actions.Resolve(Handle);
+	return Actions.IsOccupied(Index) && !Actions[Index].bPendingFinish;
+}
+
+float UActionComponent::GetTimeRatio(const FActionHandle& Handle) const
+{
+	const FAction* Action = GetAction(Handle);
+	return Action ? Action->GetTimeRadio() : 0.0f;
+}
+
+FAction* UActionComponent::GetAction(const FActionHandle& Handle) const
+{
+	const int32 Index = Actions.Resolve(Handle);
+	return Actions.IsOccupied(Index) ? Actions[Index].Action.Get() : nullptr;
 }
 
 void UActionComponent::Initialize()
@@ -85,14 +194,10 @@ void UActionComponent::Initialize()
 
 void UActionComponent::Cleanup()
 {
-	TArray<EActionType> KeyArray;
-	Actions.GetKeys(KeyArray);
-	for (auto Key : KeyArray)
-	{
-		EActionType IsType = Key;
-		FinishActionsByType(IsType, EActionResult::Clean);
-	}
+	CancelQueuedActions();
+	FinishAllActions(EActionResult::Clean);
 	Actions.Empty();
+	NotifyAllSlotsChanged();
 }
 
 void UActionComponent::InitializeComponent()
@@ -112,158 +217,468 @@ bool UActionComponent::GetComponentClassCanReplicate() const
 	return false;
 }
 
-void UActionComponent::FinishActionsByType(EActionType InType, EActionResult Result /*= EActionResult::Abort*/, const FString& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
+void UActionComponent::FinishActionsByType(EActionType InType, EActionResult Result /*= EActionResult::Abort*/, const FActionFinishReason& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
 {
+	ResolveActionTypes();
+	if (InType != EActionType::Default && !Actions.ContainsType(InType))
+		return;
+
 	UpdatePawn();
 
-	if (Actions.Contains(InType))
+	const int32 MaxIndex = Actions.GetMaxIndex();
+	for (int32 Index = 0; Index < MaxIndex; ++Index)
 	{
-		TArray<TSharedPtr<FAction>> TypeActions = Actions[InType];
-		Actions[InType].Reset();
-		for (auto Action : TypeActions)
+		if (Actions.IsOccupied(Index) && Actions[Index].Type == InType)
 		{
-			if (Action.IsValid())
+			TSharedPtr<FAction> Action = Actions.RemoveAt(Index);
+			if (Action->DoFinishAction(Result, Reason, StopType) == false)
 			{
-				if (Action->DoFinishAction(Result, Reason, StopType) == false)
-				{
-					if (!Actions.Contains(Action->GetType()))
-					{
-						Actions.Add(Action->GetType(), TArray<TSharedPtr<FAction>>());
-					}
-					Actions[Action->GetType()].Add(Action);
-				}
+				Actions.Add(Action, Action->GetType(), Index);
 			}
+			NotifySlotChanged(Index);
 		}
 	}
+	StartQueuedActions();
 }
 
-void UActionComponent::FinishAction(FAction *InAction, EActionResult Result /*= EActionResult::Abort*/, const FString& Reason /*= EActionFinishReason::UnKnown*/)
+void UActionComponent::FinishAllActions(EActionResult Result /*= EActionResult::Abort*/, const FActionFinishReason& Reason /*= EActionFinishReason::UnKnown*/)
 {
-	if (!InAction)
-		return;
-
 	UpdatePawn();
 
-	if (Actions.Contains(InAction->GetType()))
+	const int32 MaxIndex = Actions.GetMaxIndex();
+	for (int32 Index = 0; Index < MaxIndex; ++Index)
 	{
-		TSharedPtr<FAction> Action;
-		for (auto Iter : Actions[InAction->GetType()])
+		TSharedPtr<FAction> Action = Actions.RemoveAt(Index);
+		if (Action.IsValid())
 		{
-			if (Iter.Get() == InAction)
+			if (Action->DoFinishAction(Result, Reason) == false)
 			{
-				Action = Iter;
-				break;
+				Actions.Add(Action, Action->GetType(), Index);
 			}
-		}
-		Actions[InAction->GetType()].Remove(Action);
-		if (Action.IsValid())
-		{
-			Action->DoFinishAction(Result);
+			NotifySlotChanged(Index);
 		}
 	}
 }
 
-void UActionComponent::ActionTypeChanged(FAction *InAction, EActionType OldType)
+void UActionComponent::FinishAction(FAction *InAction, EActionResult Result /*= EActionResult::Abort*/, const FActionFinishReason& Reason /*= EActionFinishReason::UnKnown*/)
 {
 	if (!InAction)
 		return;
-	TSharedPtr<FAction> Action;
-	if (Actions.Contains(OldType))
+
+	const int32 Index = Actions.Find(InAction);
+	if (bIsTickingActions)
 	{
-		for (auto Iter : Actions[OldType])
+		if (Actions.IsOccupied(Index) && !Actions[Index].bPendingFinish)
 		{
-			if (Iter.Get() == InAction)
-			{
-				Action = Iter;
-				break;
-			}
+			Actions.MarkPendingFinish(Index);
+			FActionCommand& Command = PendingCommands[PendingCommands.AddDefaulted()];
+			Command.Command = EActionCommand::Finish;
+			Command.Action = Actions[Index].Action;
+			Command.Result = Result;
+			Command.Reason = Reason;
 		}
-		if (Action.IsValid())
+		return;
+	}
+
+	UpdatePawn();
+
+	TSharedPtr<FAction> Action = Actions.RemoveAt(Index);
+	if (Action.IsValid())
+	{
+		if (Action->DoFinishAction(Result, Reason) == false)
 		{
-			Actions[OldType].Remove(Action);
+			// Refused, it keeps running in its slot under the same handle.
+			Actions.Add(Action, Action->GetType(), Index);
 		}
+		NotifySlotChanged(Index);
+		StartQueuedActions();
 	}
-	if (Action.IsValid())
+}
+
+void UActionComponent::MarkActionTypeDirty(FAction *InAction)
+{
+	const int32 Index = Actions.Find(InAction);
+	if (Index == INDEX_NONE)
+		return;
+	DirtyTypeSlots.AddUnique(Index);
+	if (QueuedActions.Num() > 0)
+	{
+		WakeActionTick();
+	}
+}
+
+void UActionComponent::ResolveActionTypes()
+{
+	if (DirtyTypeSlots.Num() == 0)
+		return;
+
+	SCOPE_CYCLE_COUNTER(STAT_ActionResolveTypes);
+	for (int32 Index : DirtyTypeSlots)
 	{
-		if (!Actions.Contains(Action->GetType()))
+		if (!Actions.IsOccupied(Index))
+			continue;
+		const EActionType NewType = Actions[Index].Action->GetType();
+		if (NewType != Actions[Index].Type)
 		{
-			Actions.Add(Action->GetType(), TArray<TSharedPtr<FAction>>());
+			INC_DWORD_STAT(STAT_ActionTypeRebuckets);
+			Actions.SetType(Index, NewType);
 		}
-		Actions[Action->GetType()].Add(Action);
 	}
+	DirtyTypeSlots.Reset();
 }
 
 void UActionComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction)
 {
 	UActorComponent::TickComponent(DeltaTime, TickType, ThisTickFunction);
-	TMap<EActionType, TArray<TSharedPtr<FAction>>> TempActions = Actions;
-	for (auto& Pair : TempActions)
+
+	BeginTickActions();
+	const int32 MaxIndex = Actions.GetMaxIndex();
+	for (int32 Index = 0; Index < MaxIndex; ++Index)
 	{
-		for (auto& Action : Pair.Value)
+		if (Actions.IsOccupied(Index))
 		{
-			if (Action.IsValid())
-			{
-				EActionResult Result = Action->DoTickAction(DeltaTime);
-				if (Result != EActionResult::Wait)
-				{
-					FinishAction(Action.Get(), Result);
-				}
-			}
+			TickActionSlot(Index, Actions[Index].Action.Get(), DeltaTime);
 		}
 	}
+	EndTickActions();
 }
 
-bool UActionComponent::UpdatePawn(bool bForce /*= false*/)
+void UActionComponent::RegisterComponentTickFunctions(bool bRegister)
 {
-	if (Pawn == nullptr || bForce == true)
+	if (bRegister)
 	{
-		Pawn = Cast<APawn>(GetOwner());
-		Character = Cast<ACharacter>(GetOwner());
-		if (Pawn == nullptr)
+		UActionTickManager* Manager = UActionTickManager::IsBatchedTickEnabled() ? UActionTickManager::Get(GetWorld()) : nullptr;
+		if (Manager)
 		{
-			AController *MyController = Cast<AController>(GetOwner());
-			if (MyController)
+			Manager->RegisterComponent(this);
+			return;
+		}
+	}
+	else if (TickManager)
+	{
+		TickManager->UnregisterComponent(this);
+		return;
+	}
+	Super::RegisterComponentTickFunctions(bRegister);
+}
+
+void UActionComponent::BeginTickActions()
+{
+	bIsTickingActions = true;
+}
+
+void UActionComponent::TickActionSlot(int32 Index, FAction* Action, float DeltaTime)
+{
+	if (Actions.IsOccupied(Index) && Actions[Index].Action.Get() == Action && !Actions[Index].bPendingFinish)
+	{
+		EActionResult Result = Action->DoTickAction(DeltaTime);
+		if (Result != EActionResult::Wait)
+		{
+			FinishAction(Action, Result);
+		}
+	}
+}
+
+void UActionComponent::EndTickActions()
+{
+	bIsTickingActions = false;
+	FlushPendingCommands();
+	ResolveActionTypes();
+	StartQueuedActions();
+
+	for (const FActionSlot& Slot : Actions)
+	{
+		if (Slot.Action->NeedsTick())
+		{
+			return;
+		}
+	}
+	for (const FQueuedAction& Queued : QueuedActions)
+	{
+		if (Queued.Deadline >= 0.0f)
+		{
+			return;
+		}
+	}
+	SetActionTickEnabled(false);
+}
+
+void UActionComponent::WakeActionTick()
+{
+	if (bActionTickSleeping)
+	{
+		SetActionTickEnabled(true);
+	}
+}
+
+void UActionComponent::SetActionTickEnabled(bool bEnabled)
+{
+	bActionTickSleeping = !bEnabled;
+	if (!TickManager)
+	{
+		SetComponentTickEnabled(bEnabled);
+	}
+}
+
+void UActionComponent::NotifySlotChanged(int32 Index)
+{
+	if (TickManager)
+	{
+		TickManager->UpdateSlot(this, Index);
+	}
+}
+
+void UActionComponent::NotifyAllSlotsChanged()
+{
+	for (int32 Index = 0; TickManager && Index < TickEntryRefs.Num(); ++Index)
+	{
+		TickManager->UpdateSlot(this, Index);
+	}
+}
+
+void UActionComponent::FlushPendingCommands()
+{
+	for (int32 Index = 0; Index < PendingCommands.Num(); ++Index)
+	{
+		FActionCommand& Command = PendingCommands[Index];
+		switch (Command.Command)
+		{
+		case EActionCommand::Execute:
+			if (Actions.IsReserved(Actions.Resolve(Command.Handle)))
+			{
+				ExecuteActionInSlot(Command.Action, Command.Handle.Index);
+			}
+			else
 			{
-				Pawn = Cast<APawn>(MyController->GetPawn());
-				Character = Cast<ACharacter>(Pawn);
+				Command.Action->Complete(EActionResult::Abort, EActionFinishReason::CustomStop);
 			}
+			break;
+		case EActionCommand::Finish:
+			FinishAction(Command.Action.Get(), Command.Result, Command.Reason);
+			break;
+		case EActionCommand::StopByType:
+			StopActionsByType(Command.Type, Command.bForce, Command.Reason);
+			break;
+		case EActionCommand::StopAll:
+			StopAllAction(Command.Reason);
+			break;
 		}
 	}
+	PendingCommands.Reset();
+}
+
+bool UActionComponent::UpdatePawn(bool bForce /*= false*/)
+{
+	if (bForce)
+	{
+		bOwnerContextDirty = true;
+	}
+	const FActionOwnerContext& Context = GetOwnerContext();
+	Pawn = Context.Pawn;
+	Character = Context.Character;
 
 	return Pawn != NULL;
 }
 
-void UActionComponent::ExecuteAction(TSharedPtr<FAction> NewAction)
+void UActionComponent::RefreshOwnerContext()
+{
+	bOwnerContextDirty = false;
+	if (OwnerContext.Mesh)
+	{
+		OwnerContext.Mesh->OnAnimInitialized.RemoveDynamic(this, &UActionComponent::OnOwnerAnimInitialized);
+	}
+
+	OwnerContext = FActionOwnerContext();
+	OwnerController = Cast<AController>(GetOwner());
+	OwnerContext.Pawn = OwnerController ? OwnerController->GetPawn() : Cast<APawn>(GetOwner());
+	OwnerContext.Character = Cast<ACharacter>(OwnerContext.Pawn);
+	if (OwnerContext.Character)
+	{
+		OwnerContext.Movement = OwnerContext.Character->GetCharacterMovement();
+		OwnerContext.Mesh = OwnerContext.Character->GetMesh();
+	}
+	else if (OwnerContext.Pawn)
+	{
+		OwnerContext.Mesh = OwnerContext.Pawn->FindComponentByClass<USkeletalMeshComponent>();
+	}
+	if (OwnerContext.Mesh)
+	{
+		OwnerContext.AnimInstance = OwnerContext.Mesh->GetAnimInstance();
+		OwnerContext.Mesh->OnAnimInitialized.AddUniqueDynamic(this, &UActionComponent::OnOwnerAnimInitialized);
+	}
+}
+
+void UActionComponent::OnOwnerAnimInitialized()
+{
+	bOwnerContextDirty = true;
+}
+
+FActionHandle UActionComponent::ExecuteAction(TSharedPtr<FAction> NewAction)
 {
 	if (!NewAction.IsValid())
-		return;
+		return FActionHandle();
 
+	if (bIsTickingActions)
+	{
+		FActionCommand& Command = PendingCommands[PendingCommands.AddDefaulted()];
+		Command.Command = EActionCommand::Execute;
+		Command.Action = NewAction;
+		Command.Handle = Actions.GetHandle(Actions.Reserve());
+		return Command.Handle;
+	}
+
+	return ExecuteActionInSlot(NewAction, INDEX_NONE);
+}
+
+FActionHandle UActionComponent::ExecuteAction(TSharedPtr<FAction> NewAction, TSharedFuture<FActionOutcome>& OutCompletion)
+{
+	if (!NewAction.IsValid())
+		return FActionHandle();
+
+	OutCompletion = NewAction->GetCompletion();
+	return ExecuteAction(NewAction);
+}
+
+FActionHandle UActionComponent::ExecuteActionInSlot(TSharedPtr<FAction> NewAction, int32 ReservedIndex)
+{
 	UpdatePawn();
+	ResolveActionTypes();
+
+	EActionType PreemptedTypes = EActionType::Default;
+	if (ResolveConflict(NewAction.Get(), PreemptedTypes) == EActionConflictPolicy::Queue)
+		return QueueAction(NewAction, ReservedIndex);
 
-	StopActionsByType(NewAction->GetType(), false);
+	AbortActionsInChannels(PreemptedTypes, NewAction->GetType(), EActionFinishReason::CustomStop);
 
 	NewAction->SetActionComponent(this);
 	NewAction->SetOwner(Pawn);
 	EActionResult Result = NewAction->DoExecuteAction();
 	if (Result == EActionResult::Wait)
 	{
-		if (!Actions.Contains(NewAction->GetType()))
+		const int32 Index = Actions.Add(NewAction, NewAction->GetType(), ReservedIndex);
+		NotifySlotChanged(Index);
+		return Actions.GetHandle(Index);
+	}
+	Actions.CancelReservation(ReservedIndex);
+	return FActionHandle();
+}
+
+FActionHandle UActionComponent::QueueAction(const TSharedPtr<FAction>& NewAction, int32 ReservedIndex)
+{
+	INC_DWORD_STAT(STAT_ActionPreemptionsAvoided);
+
+	if (NewAction->QueueTimeout == 0.0f)
+	{
+		Actions.CancelReservation(ReservedIndex);
+		NewAction->ExecutePostFinish(EActionResult::Fail, EActionFinishReason::Rejected);
+		return FActionHandle();
+	}
+
+	// A newer request for the same channels replaces the one still waiting, so re-issuing it every frame does not pile up.
+	for (int32 Index = QueuedActions.Num() - 1; Index >= 0; --Index)
+	{
+		if (QueuedActions[Index].Action->GetType() == NewAction->GetType())
 		{
-			Actions.Add(NewAction->GetType(), TArray<TSharedPtr<FAction>>());
+			DropQueuedAction(Index, EActionFinishReason::Rejected);
 		}
-		Actions[NewAction->GetType()].Add(NewAction);
 	}
+
+	int32 InsertIndex = 0;
+	while (InsertIndex < QueuedActions.Num() && QueuedActions[InsertIndex].Action->ActionPriority >= NewAction->ActionPriority)
+	{
+		++InsertIndex;
+	}
+	if (InsertIndex >= MaxQueuedActions)
+	{
+		Actions.CancelReservation(ReservedIndex);
+		NewAction->ExecutePostFinish(EActionResult::Fail, EActionFinishReason::Rejected);
+		return FActionHandle();
+	}
+	if (QueuedActions.Num() >= MaxQueuedActions)
+	{
+		DropQueuedAction(QueuedActions.Num() - 1, EActionFinishReason::Rejected);
+	}
+
+	FQueuedAction Queued;
+	Queued.Action = NewAction;
+	Queued.Handle = Actions.GetHandle(Actions.IsReserved(ReservedIndex) ? ReservedIndex : Actions.Reserve());
+	Queued.Deadline = -1.0f;
+	if (NewAction->QueueTimeout > 0.0f)
+	{
+		Queued.Deadline = GetActionTime() + NewAction->QueueTimeout;
+		WakeActionTick();
+	}
+	QueuedActions.Insert(Queued, InsertIndex);
+	return Queued.Handle;
 }
 
-void UActionComponent::StopAllAction(const FString& Reason /*= EActionFinishReason::CustomStop*/)
+void UActionComponent::DropQueuedAction(int32 Index, const FActionFinishReason& Reason)
 {
-	TArray<EActionType> KeyArray;
-	Actions.GetKeys(KeyArray);
-	for (auto Key : KeyArray)
+	const FQueuedAction Queued = QueuedActions[Index];
+	QueuedActions.RemoveAt(Index);
+	Actions.CancelReservation(Actions.Resolve(Queued.Handle));
+	Queued.Action->ExecutePostFinish(EActionResult::Fail, Reason);
+}
+
+void UActionComponent::StopAllAction(const FActionFinishReason& Reason /*= EActionFinishReason::CustomStop*/)
+{
+	if (bIsTickingActions)
 	{
-		EActionType IsType = Key;
-		FinishActionsByType(IsType, EActionResult::Abort, Reason);
+		FActionCommand& Command = PendingCommands[PendingCommands.AddDefaulted()];
+		Command.Command = EActionCommand::StopAll;
+		Command.Reason = Reason;
+		return;
 	}
+
+	CancelQueuedActions();
+	FinishAllActions(EActionResult::Abort, Reason);
 	Actions.Empty();
+	NotifyAllSlotsChanged();
+}
+
+void UActionComponent::StartQueuedActions()
+{
+	if (bIsTickingActions || bStartingQueuedActions || QueuedActions.Num() == 0)
+		return;
+
+	TGuardValue<bool> Guard(bStartingQueuedActions, true);
+	ResolveActionTypes();
+	const float TimeSeconds = GetActionTime();
+	for (int32 Index = 0; Index < QueuedActions.Num();)
+	{
+		if (!Actions.IsReserved(Actions.Resolve(QueuedActions[Index].Handle)))
+		{
+			QueuedActions[Index].Action->Complete(EActionResult::Abort, EActionFinishReason::CustomStop);
+			QueuedActions.RemoveAt(Index);
+			continue;
+		}
+
+		if (QueuedActions[Index].Deadline >= 0.0f && TimeSeconds >= QueuedActions[Index].Deadline)
+		{
+			DropQueuedAction(Index, EActionFinishReason::QueueTimeout);
+			continue;
+		}
+
+		EActionType PreemptedTypes;
+		if (ResolveConflict(QueuedActions[Index].Action.Get(), PreemptedTypes) == EActionConflictPolicy::Queue)
+		{
+			++Index;
+			continue;
+		}
+
+		FQueuedAction Queued = QueuedActions[Index];
+		QueuedActions.RemoveAt(Index);
+		ExecuteActionInSlot(Queued.Action, Queued.Handle.Index);
+	}
+}
+
+void UActionComponent::CancelQueuedActions()
+{
+	for (const FQueuedAction& Queued : QueuedActions)
+	{
+		Actions.CancelReservation(Actions.Resolve(Queued.Handle));
+		Queued.Action->Complete(EActionResult::Abort, EActionFinishReason::CustomStop);
+	}
+	QueuedActions.Reset();
 }
 
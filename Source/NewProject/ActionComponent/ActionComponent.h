@@ -4,8 +4,13 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "GameFramework/Controller.h"
 #include "IDelegateInstance.h"
 #include "ActionEnums.h"
+#include "ActionSlotArray.h"
+#include "ActionConflict.h"
+#include "ActionOwnerContext.h"
+#include "ActionTickManager.h"
 #include "ActionComponent.generated.h"
 
 class ACharacter;
@@ -15,12 +20,42 @@ class Action;
 
 NEWPROJECT_API DECLARE_LOG_CATEGORY_EXTERN(LogActionComponent, Warning, All);
 
+enum class EActionCommand : uint8
+{
+	Execute,
+	Finish,
+	StopByType,
+	StopAll
+};
+
+/** A structural change requested while the component is ticking its actions, applied once the tick loop is done. */
+struct FActionCommand
+{
+	EActionCommand Command;
+	TSharedPtr<FAction> Action;
+	EActionResult Result;
+	EActionType Type;
+	bool bForce;
+	FActionFinishReason Reason;
+	FActionHandle Handle;
+};
+
+/** An action waiting for the channels its conflict policy queues it behind, its handle names the slot reserved for it. */
+struct FQueuedAction
+{
+	TSharedPtr<FAction> Action;
+	FActionHandle Handle;
+	/** World time at which the action gives up waiting, negative for never. */
+	float Deadline;
+};
+
 UCLASS()
 class NEWPROJECT_API UActionComponent : public UActorComponent
 {
 	GENERATED_UCLASS_BODY()
 
 	friend class FAction;
+	friend class UActionTickManager;
 
 public:
 
@@ -33,23 +68,73 @@ public:
 
 	virtual bool GetComponentClassCanReplicate() const override;
 
-	void ExecuteAction(TSharedPtr<FAction> NewAction);
-	void StopAllAction(const FString& Reason = EActionFinishReason::CustomStop);
-	void StopMoveAction(const FString& Reason = EActionFinishReason::CustomStop);
-	void StopAction(FAction *InAction, const FString& Reason = EActionFinishReason::CustomStop);
-	void StopActionsByType(EActionType InType, bool bForce = true, const FString& Reason = EActionFinishReason::CustomStop);
+	FActionHandle ExecuteAction(TSharedPtr<FAction> NewAction);
+	/** Also returns the future set once NewAction has finished, been rejected or been dropped from the queue, so callers need not poll. */
+	FActionHandle ExecuteAction(TSharedPtr<FAction> NewAction, TSharedFuture<FActionOutcome>& OutCompletion);
+	void StopAllAction(const FActionFinishReason& Reason = EActionFinishReason::CustomStop);
+	void StopMoveAction(const FActionFinishReason& Reason = EActionFinishReason::CustomStop);
+	void StopAction(FAction *InAction, const FActionFinishReason& Reason = EActionFinishReason::CustomStop);
+	void StopAction(const FActionHandle& Handle, const FActionFinishReason& Reason = EActionFinishReason::CustomStop);
+	/** Aborts the actions sharing a channel with InType, or without bForce only those InType preempts according to the conflict matrix. */
+	void StopActionsByType(EActionType InType, bool bForce = true, const FActionFinishReason& Reason = EActionFinishReason::CustomStop);
+
+	const FActionSlotArray &GetAllActions() const { return Actions; }
 
-	const TMap<EActionType, TArray<TSharedPtr<FAction>>> &GetAllActions() const { return Actions; }
+	/** Clock of every deadline kept by the component and its actions, in world seconds. */
+	float GetActionTime() const;
+
+	/** Leaf actions running under every root action, rebuilt only after the action trees changed. */
+	const TArray<const FAction*>& GetActiveLeafActions();
 
 	bool IsContainType(EActionType InType);
 
+	/** Whether the action named by Handle is running, false once it finished and while it is deferred or queued. */
+	bool IsRunning(const FActionHandle& Handle) const;
+	float GetTimeRatio(const FActionHandle& Handle) const;
+	FAction* GetAction(const FActionHandle& Handle) const;
+
+	FORCEINLINE const FActionOwnerContext& GetOwnerContext()
+	{
+		if (bOwnerContextDirty || (OwnerController && OwnerController->GetPawn() != OwnerContext.Pawn))
+		{
+			RefreshOwnerContext();
+		}
+		return OwnerContext;
+	}
+
+	/** Call after swapping components on the owner, possession and anim instance changes are picked up automatically. */
+	void InvalidateOwnerContext() { bOwnerContextDirty = true; }
+
 protected:
 
-	void FinishActionsByType(EActionType InType, EActionResult Result = EActionResult::Abort, const FString& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default);
-	void FinishAction(FAction *InAction, EActionResult Result = EActionResult::Abort, const FString& Reason = EActionFinishReason::UnKnown);
-	void ActionTypeChanged(FAction *InAction, EActionType OldType);
+	void FinishActionsByType(EActionType InType, EActionResult Result = EActionResult::Abort, const FActionFinishReason& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default);
+	void FinishAllActions(EActionResult Result = EActionResult::Abort, const FActionFinishReason& Reason = EActionFinishReason::UnKnown);
+	void FinishAction(FAction *InAction, EActionResult Result = EActionResult::Abort, const FActionFinishReason& Reason = EActionFinishReason::UnKnown);
+	/** Queues the slot of InAction, a root whose type may have changed, for ResolveActionTypes. */
+	void MarkActionTypeDirty(FAction *InAction);
+	/**
+	 * Re-buckets every root marked dirty since the last call, done before the slot types are read.
+	 * Never starts queued actions, that only happens at the end of a tick or after a stop or finish.
+	 */
+	void ResolveActionTypes();
+
+	FActionHandle ExecuteActionInSlot(TSharedPtr<FAction> NewAction, int32 ReservedIndex);
+
+	/** Returns Queue when InAction has to wait, otherwise the channels whose running actions it aborts when it starts. */
+	EActionConflictPolicy ResolveConflict(const FAction* InAction, EActionType& OutPreemptedTypes) const;
+	int32 GetHighestPriority(EActionType InType) const;
+	void AbortActionsInChannels(EActionType InChannels, EActionType StopType, const FActionFinishReason& Reason);
+	FActionHandle QueueAction(const TSharedPtr<FAction>& NewAction, int32 ReservedIndex);
 
 	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction) override;
+	virtual void RegisterComponentTickFunctions(bool bRegister) override;
+
+	void BeginTickActions();
+	void TickActionSlot(int32 Index, FAction* Action, float DeltaTime);
+	void EndTickActions();
+
+	void WakeActionTick();
+	void SetActionTickEnabled(bool bEnabled);
 
 	UPROPERTY(Transient)
 	ACharacter *Character;
@@ -57,7 +142,59 @@ protected:
 	UPROPERTY(Transient)
 	APawn *Pawn;
 
-	TMap<EActionType, TArray<TSharedPtr<FAction>>> Actions;
+	UPROPERTY(Transient)
+	FActionOwnerContext OwnerContext;
+
+	/** Owner of the component when it is a controller, its possessed pawn is compared against the cached one. */
+	UPROPERTY(Transient)
+	AController* OwnerController;
+
+	bool bOwnerContextDirty = true;
+
+	void RefreshOwnerContext();
+
+	UFUNCTION()
+	void OnOwnerAnimInitialized();
+
+	FActionSlotArray Actions;
+
+	TArray<const FAction*> ActiveLeafActions;
+	uint32 ActiveLeafActionsRevision = 0;
+	bool bActiveLeafActionsDirty = true;
+
+	void InvalidateActiveLeafActions() { bActiveLeafActionsDirty = true; }
+
+	TArray<int32, TInlineAllocator<4>> DirtyTypeSlots;
+
+	bool bIsTickingActions = false;
+
+	/** Manager ticking this component in place of its own tick function, set while it is registered there. */
+	UActionTickManager* TickManager = nullptr;
+	/** Where TickManager filed the action of each slot, indexed by slot. */
+	TArray<FActionTickEntryRef> TickEntryRefs;
+
+	/** Keeps TickManager's buckets in step after an action entered or left slot Index. */
+	void NotifySlotChanged(int32 Index);
+	void NotifyAllSlotsChanged();
+
+	bool bActionTickSleeping = false;
+
+	TArray<FActionCommand> PendingCommands;
+
+	void FlushPendingCommands();
+
+	TArray<FQueuedAction> QueuedActions;
+
+	/** Queued actions past this count are rejected, the lowest priority and oldest first. */
+	static const int32 MaxQueuedActions = 8;
+
+	/** Removes the queued action at Index, failing it with Reason. */
+	void DropQueuedAction(int32 Index, const FActionFinishReason& Reason);
+
+	bool bStartingQueuedActions = false;
+
+	void StartQueuedActions();
+	void CancelQueuedActions();
 
 	TMap<FString, FAction*> SyncActions;
 
@@ -0,0 +1,32 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "ActionComponentSettings.h"
+
+const FActionConflictMatrix& UActionComponentSettings::GetConflictMatrix()
+{
+	const UActionComponentSettings* Settings = GetDefault<UActionComponentSettings>();
+	if (Settings->bConflictMatrixDirty)
+	{
+		Settings->ConflictMatrix = FActionConflictMatrix();
+		for (const FActionConflictRule& Rule : Settings->ConflictRules)
+		{
+			Settings->ConflictMatrix.SetPolicy((int32)Rule.Incoming, (int32)Rule.Running, Rule.Policy);
+		}
+		Settings->bConflictMatrixDirty = false;
+	}
+	return Settings->ConflictMatrix;
+}
+
+#if WITH_EDITOR
+void UActionComponentSettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	bConflictMatrixDirty = true;
+}
+#endif
+
+void UActionComponentSettings::PostReloadConfig(UProperty* PropertyThatWasLoaded)
+{
+	Super::PostReloadConfig(PropertyThatWasLoaded);
+	bConflictMatrixDirty = true;
+}
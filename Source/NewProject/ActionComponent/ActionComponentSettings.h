@@ -0,0 +1,45 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "ActionConflict.h"
+#include "ActionComponentSettings.generated.h"
+
+UCLASS(config = Game, defaultconfig, meta = (DisplayName = "Action Component"))
+class NEWPROJECT_API UActionComponentSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	/** Applied in order on top of the default FActionConflictMatrix. */
+	UPROPERTY(config, EditAnywhere, Category = "Conflict")
+	TArray<FActionConflictRule> ConflictRules;
+
+	static const FActionConflictMatrix& GetConflictMatrix();
+
+	/**
+	 * FAction_ServerMoveTo reuses its last floor check while the agent stays within this many capsule radii of it horizontally,
+	 * zero checks every tick. In between it follows the plane of the cached floor, so a step is only climbed at the next check;
+	 * below one radius the capsule's rounded bottom hides that, while a few frames at walking speed skip the sweep.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Floor", meta = (ClampMin = "0"))
+	float FloorCacheRadiusScale = 0.75f;
+
+	/** Agents farther than this from every player's pawn check the floor only every FarFloorCheckInterval seconds, zero disables it. */
+	UPROPERTY(config, EditAnywhere, Category = "Floor", meta = (ClampMin = "0"))
+	float FarFloorCheckDistance = 0.0f;
+
+	UPROPERTY(config, EditAnywhere, Category = "Floor", meta = (ClampMin = "0"))
+	float FarFloorCheckInterval = 0.25f;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+	virtual void PostReloadConfig(UProperty* PropertyThatWasLoaded) override;
+
+protected:
+	mutable FActionConflictMatrix ConflictMatrix;
+	mutable bool bConflictMatrixDirty = true;
+};
@@ -0,0 +1,511 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "ActionComponent.h"
+#include "ActionPool.h"
+#include "Action_Sequence.h"
+#include "Action_Parallel.h"
+#include "Action_Program.h"
+#include "Action_Repeat.h"
+#include "Action_Retry.h"
+#include "Action_Race.h"
+#include "Action_Timeout.h"
+#include "Action_Script.h"
+
+namespace ActionCompositeTests
+{
+	static const uint32 TestFlags = EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter;
+
+	static const TCHAR* ResultToString(EActionResult Result)
+	{
+		switch (Result)
+		{
+		case EActionResult::Wait: return TEXT("Wait");
+		case EActionResult::Success: return TEXT("Success");
+		case EActionResult::Fail: return TEXT("Fail");
+		case EActionResult::Abort: return TEXT("Abort");
+		case EActionResult::Clean: return TEXT("Clean");
+		}
+		return TEXT("?");
+	}
+
+	/** Every PostFinish of a run in call order, as "Name:Result". */
+	typedef TArray<FString> FFinishLog;
+
+	/**
+	 * Leaf finishing with Result after NumTicks ticks, immediately when NumTicks is zero, and logging its PostFinish.
+	 * RunResults overrides Result for the first executions, one entry per execution. An event driven step never asks
+	 * for ticks, it waits for its parent to stop it.
+	 */
+	class FTestStep : public FAction
+	{
+	public:
+		DECLARE_ACTION_CLASS()
+
+		static TSharedPtr<FTestStep> CreateAction(FName InName, int32 InNumTicks, EActionResult InResult, FFinishLog& Log)
+		{
+			TSharedPtr<FTestStep> Action = TActionPool<FTestStep>::Acquire();
+			if (Action.IsValid())
+			{
+				Action->Name = InName;
+				Action->NumTicks = InNumTicks;
+				Action->Result = InResult;
+				FFinishLog* LogPtr = &Log;
+				Action->EditHooks().PostFinish.BindLambda([LogPtr](FAction* InAction, EActionResult InResult, const FActionFinishReason&)
+				{
+					LogPtr->Add(FString::Printf(TEXT("%s:%s"), *InAction->GetName().ToString(), ResultToString(InResult)));
+				});
+			}
+			return Action;
+		}
+
+		virtual void ResetAction() override { *this = FTestStep(); }
+		virtual TSharedPtr<FAction> CloneAction() const override { return TActionPool<FTestStep>::Clone(*this); }
+		virtual void RearmAction() override { TicksLeft = 0; }
+		virtual FName GetName() const override { return Name; }
+		virtual bool NeedsTick() const override { return !bEventDriven; }
+
+		TArray<EActionResult> RunResults;
+		int32 NumRuns = 0;
+		bool bEventDriven = false;
+
+	protected:
+		virtual EActionResult ExecuteAction() override
+		{
+			RunResult = RunResults.IsValidIndex(NumRuns) ? RunResults[NumRuns] : Result;
+			++NumRuns;
+			TicksLeft = NumTicks;
+			return TicksLeft > 0 ? EActionResult::Wait : RunResult;
+		}
+
+		virtual EActionResult TickAction(float DeltaTime) override
+		{
+			return --TicksLeft > 0 ? EActionResult::Wait : RunResult;
+		}
+
+		FName Name;
+		int32 NumTicks = 0;
+		int32 TicksLeft = 0;
+		EActionResult Result = EActionResult::Success;
+		EActionResult RunResult = EActionResult::Success;
+	};
+
+	/** Game world with no map and one action component, torn down with this object. */
+	struct FTestWorld
+	{
+		UWorld* World = nullptr;
+		UActionComponent* Component = nullptr;
+
+		FTestWorld()
+		{
+			World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("ActionCompositeTestWorld"));
+			FWorldContext& Context = GEngine->CreateNewWorldContext(EWorldType::Game);
+			Context.SetCurrentWorld(World);
+			World->InitializeActorsForPlay(FURL());
+			World->BeginPlay();
+
+			AActor* Actor = World->SpawnActor<AActor>();
+			Component = NewObject<UActionComponent>(Actor);
+			Component->RegisterComponent();
+		}
+
+		~FTestWorld()
+		{
+			GEngine->DestroyWorldContext(World);
+			World->DestroyWorld(false);
+		}
+
+		void Tick(int32 NumFrames = 1, float DeltaTime = 1.0f / 30.0f)
+		{
+			for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+			{
+				World->Tick(LEVELTICK_All, DeltaTime);
+			}
+		}
+
+		/** Executes Action and ticks until it finishes or MaxFrames pass, then logs the root as "Root:Result" and returns its outcome. */
+		FActionOutcome Run(const TSharedPtr<FAction>& Action, FFinishLog& Log, int32 MaxFrames = 100)
+		{
+			TSharedFuture<FActionOutcome> Completion;
+			Component->ExecuteAction(Action, Completion);
+			for (int32 Frame = 0; Frame < MaxFrames && !Completion.IsReady(); ++Frame)
+			{
+				Tick();
+			}
+			if (!Completion.IsReady())
+			{
+				Log.Add(TEXT("Root:Running"));
+				return FActionOutcome{ EActionResult::Wait, FActionFinishReason() };
+			}
+			Log.Add(FString::Printf(TEXT("Root:%s"), ResultToString(Completion.Get().Result)));
+			return Completion.Get();
+		}
+	};
+
+	/** Runs the tree Builder makes in a fresh world and returns its finish log joined with ", ". */
+	static FString RunLog(TFunctionRef<TSharedPtr<FAction>(FFinishLog&)> Builder, int32 MaxFrames = 100)
+	{
+		FFinishLog Log;
+		{
+			FTestWorld TestWorld;
+			TestWorld.Run(Builder(Log), Log, MaxFrames);
+		}
+		return FString::Join(Log, TEXT(", "));
+	}
+}
+
+/** Every join policy of FAction_Parallel, checked by the results its children and the group finish with and their order. */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActionParallelJoinTest, "ActionComponent.Composites.ParallelJoinPolicies", ActionCompositeTests::TestFlags)
+
+bool FActionParallelJoinTest::RunTest(const FString& Parameters)
+{
+	using namespace ActionCompositeTests;
+
+	TestEqual(TEXT("All waits for every child"), RunLog([](FFinishLog& Log) -> TSharedPtr<FAction>
+	{
+		return FAction_Parallel::CreateAction({ FTestStep::CreateAction(TEXT("A"), 1, EActionResult::Success, Log),
+			FTestStep::CreateAction(TEXT("B"), 3, EActionResult::Success, Log), FTestStep::CreateAction(TEXT("C"), 2, EActionResult::Success, Log) });
+	}), FString(TEXT("A:Success, C:Success, B:Success, Root:Success")));
+
+	TestEqual(TEXT("All fails with the first failure"), RunLog([](FFinishLog& Log) -> TSharedPtr<FAction>
+	{
+		return FAction_Parallel::CreateAction({ FTestStep::CreateAction(TEXT("A"), 1, EActionResult::Success, Log),
+			FTestStep::CreateAction(TEXT("B"), 2, EActionResult::Fail, Log), FTestStep::CreateAction(TEXT("C"), 4, EActionResult::Success, Log) });
+	}), FString(TEXT("A:Success, B:Fail, C:Abort, Root:Fail")));
+
+	TestEqual(TEXT("Any ends with the first child"), RunLog([](FFinishLog& Log) -> TSharedPtr<FAction>
+	{
+		return FAction_Parallel::CreateAction({ FTestStep::CreateAction(TEXT("A"), 3, EActionResult::Success, Log),
+			FTestStep::CreateAction(TEXT("B"), 1, EActionResult::Success, Log) }, EActionJoinPolicy::Any);
+	}), FString(TEXT("B:Success, A:Abort, Root:Success")));
+
+	TestEqual(TEXT("Major aborts the minor"), RunLog([](FFinishLog& Log) -> TSharedPtr<FAction>
+	{
+		return FAction_Parallel::CreateAction(FTestStep::CreateAction(TEXT("A"), 2, EActionResult::Success, Log), FTestStep::CreateAction(TEXT("B"), 5, EActionResult::Success, Log));
+	}), FString(TEXT("A:Success, B:Abort, Root:Success")));
+
+	TestEqual(TEXT("Major outlives the minor"), RunLog([](FFinishLog& Log) -> TSharedPtr<FAction>
+	{
+		return FAction_Parallel::CreateAction(FTestStep::CreateAction(TEXT("A"), 3, EActionResult::Success, Log), FTestStep::CreateAction(TEXT("B"), 1, EActionResult::Fail, Log));
+	}), FString(TEXT("B:Fail, A:Success, Root:Success")));
+
+	TestEqual(TEXT("NOfM succeeds once enough children did"), RunLog([](FFinishLog& Log) -> TSharedPtr<FAction>
+	{
+		return FAction_Parallel::CreateAction({ FTestStep::CreateAction(TEXT("A"), 1, EActionResult::Success, Log), FTestStep::CreateAction(TEXT("B"), 2, EActionResult::Fail, Log),
+			FTestStep::CreateAction(TEXT("C"), 3, EActionResult::Success, Log), FTestStep::CreateAction(TEXT("D"), 5, EActionResult::Success, Log) }, EActionJoinPolicy::NOfM, 2);
+	}), FString(TEXT("A:Success, B:Fail, C:Success, D:Abort, Root:Success")));
+
+	TestEqual(TEXT("NOfM fails once too few children can succeed"), RunLog([](FFinishLog& Log) -> TSharedPtr<FAction>
+	{
+		return FAction_Parallel::CreateAction({ FTestStep::CreateAction(TEXT("A"), 1, EActionResult::Fail, Log),
+			FTestStep::CreateAction(TEXT("B"), 2, EActionResult::Fail, Log), FTestStep::CreateAction(TEXT("C"), 4, EActionResult::Success, Log) }, EActionJoinPolicy::NOfM, 2);
+	}), FString(TEXT("A:Fail, B:Fail, C:Abort, Root:Fail")));
+
+	TestEqual(TEXT("A nested group with the same policy is flattened and still runs every child"), RunLog([](FFinishLog& Log) -> TSharedPtr<FAction>
+	{
+		return FAction_Parallel::CreateAction({ FTestStep::CreateAction(TEXT("A"), 2, EActionResult::Success, Log),
+			FAction_Parallel::CreateAction({ FTestStep::CreateAction(TEXT("B"), 1, EActionResult::Success, Log), FTestStep::CreateAction(TEXT("C"), 3, EActionResult::Success, Log) }) });
+	}), FString(TEXT("B:Success, A:Success, C:Success, Root:Success")));
+	return true;
+}
+
+/** Each tree run as it is and compiled into an FAction_Program, the leaves must finish with the same results in the same order. */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActionProgramMatchesTreeTest, "ActionComponent.Composites.ProgramMatchesTree", ActionCompositeTests::TestFlags)
+
+bool FActionProgramMatchesTreeTest::RunTest(const FString& Parameters)
+{
+	using namespace ActionCompositeTests;
+	typedef TFunction<TSharedPtr<FAction>(FFinishLog&)> FTreeBuilder;
+
+	TArray<TPair<FString, FTreeBuilder>> Trees;
+	Trees.Emplace(TEXT("All"), [](FFinishLog& Log) -> TSharedPtr<FAction>
+	{
+		return FAction_Sequence::CreateAction({
+			FTestStep::CreateAction(TEXT("A"), 1, EActionResult::Success, Log),
+			FAction_Parallel::CreateAction({
+				FTestStep::CreateAction(TEXT("B"), 2, EActionResult::Success, Log),
+				FAction_Sequence::CreateAction({ FTestStep::CreateAction(TEXT("C"), 1, EActionResult::Success, Log), FTestStep::CreateAction(TEXT("D"), 3, EActionResult::Success, Log) }) }),
+			FTestStep::CreateAction(TEXT("E"), 0, EActionResult::Success, Log) });
+	});
+	Trees.Emplace(TEXT("Any"), [](FFinishLog& Log) -> TSharedPtr<FAction>
+	{
+		return FAction_Sequence::CreateAction({
+			FAction_Parallel::CreateAction({
+				FTestStep::CreateAction(TEXT("A"), 3, EActionResult::Success, Log),
+				FTestStep::CreateAction(TEXT("B"), 1, EActionResult::Fail, Log),
+				FTestStep::CreateAction(TEXT("C"), 4, EActionResult::Success, Log) }, EActionJoinPolicy::Any),
+			FTestStep::CreateAction(TEXT("D"), 1, EActionResult::Success, Log) });
+	});
+	Trees.Emplace(TEXT("Major"), [](FFinishLog& Log) -> TSharedPtr<FAction>
+	{
+		return FAction_Sequence::CreateAction({
+			FAction_Parallel::CreateAction(
+				FTestStep::CreateAction(TEXT("A"), 2, EActionResult::Success, Log),
+				FAction_Sequence::CreateAction({ FTestStep::CreateAction(TEXT("B"), 1, EActionResult::Success, Log), FTestStep::CreateAction(TEXT("C"), 5, EActionResult::Success, Log) })),
+			FTestStep::CreateAction(TEXT("D"), 1, EActionResult::Success, Log) });
+	});
+	Trees.Emplace(TEXT("NOfM"), [](FFinishLog& Log) -> TSharedPtr<FAction>
+	{
+		return FAction_Parallel::CreateAction({
+			FTestStep::CreateAction(TEXT("A"), 1, EActionResult::Success, Log),
+			FTestStep::CreateAction(TEXT("B"), 2, EActionResult::Fail, Log),
+			FTestStep::CreateAction(TEXT("C"), 3, EActionResult::Success, Log),
+			FTestStep::CreateAction(TEXT("D"), 5, EActionResult::Success, Log) }, EActionJoinPolicy::NOfM, 2);
+	});
+	Trees.Emplace(TEXT("Decided while starting"), [](FFinishLog& Log) -> TSharedPtr<FAction>
+	{
+		return FAction_Parallel::CreateAction({
+			FTestStep::CreateAction(TEXT("A"), 2, EActionResult::Success, Log),
+			FTestStep::CreateAction(TEXT("B"), 0, EActionResult::Fail, Log),
+			FTestStep::CreateAction(TEXT("C"), 2, EActionResult::Success, Log) });
+	});
+
+	// Expected logs of the tree form, for the cases whose order does not depend on the frame the root starts in.
+	TMap<FString, FString> Expected;
+	Expected.Add(TEXT("Any"), TEXT("B:Fail, A:Abort, C:Abort, Root:Fail"));
+	Expected.Add(TEXT("Major"), TEXT("B:Success, A:Success, C:Abort, D:Success, Root:Success"));
+	Expected.Add(TEXT("NOfM"), TEXT("A:Success, B:Fail, C:Success, D:Abort, Root:Success"));
+	Expected.Add(TEXT("Decided while starting"), TEXT("B:Fail, A:Abort, Root:Fail"));
+
+	for (const TPair<FString, FTreeBuilder>& Tree : Trees)
+	{
+		FFinishLog TreeLog;
+		FFinishLog ProgramLog;
+		{
+			FTestWorld TestWorld;
+			TestWorld.Run(Tree.Value(TreeLog), TreeLog);
+			TestWorld.Run(FAction_Program::Compile(Tree.Value(ProgramLog)), ProgramLog);
+		}
+		TestEqual(FString::Printf(TEXT("%s: finish order"), *Tree.Key), FString::Join(ProgramLog, TEXT(", ")), FString::Join(TreeLog, TEXT(", ")));
+		if (const FString* ExpectedLog = Expected.Find(Tree.Key))
+		{
+			TestEqual(FString::Printf(TEXT("%s: tree"), *Tree.Key), FString::Join(TreeLog, TEXT(", ")), *ExpectedLog);
+		}
+	}
+
+	// Stopped from outside while a fork runs, the interrupted leaves get what the parallel would pass them.
+	{
+		FFinishLog TreeLog;
+		FFinishLog ProgramLog;
+		const FTreeBuilder& Builder = Trees[0].Value;
+		{
+			FTestWorld TestWorld;
+			const TSharedPtr<FAction> TreeRoot = Builder(TreeLog);
+			TestWorld.Component->ExecuteAction(TreeRoot);
+			TestWorld.Tick(2);
+			TestWorld.Component->StopAction(TreeRoot.Get());
+
+			const TSharedPtr<FAction> ProgramRoot = FAction_Program::Compile(Builder(ProgramLog));
+			TestWorld.Component->ExecuteAction(ProgramRoot);
+			TestWorld.Tick(2);
+			TestWorld.Component->StopAction(ProgramRoot.Get());
+		}
+		TestEqual(TEXT("Stopped: finish order"), FString::Join(ProgramLog, TEXT(", ")), FString::Join(TreeLog, TEXT(", ")));
+		TestTrue(TEXT("Stopped: a leaf was interrupted"), TreeLog.Contains(TEXT("B:Abort")));
+	}
+	return true;
+}
+
+/** FAction_Repeat runs its child the requested number of times, stops on failure and on Until, and replays rearmed sequences. */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActionRepeatCountTest, "ActionComponent.Composites.RepeatCounts", ActionCompositeTests::TestFlags)
+
+bool FActionRepeatCountTest::RunTest(const FString& Parameters)
+{
+	using namespace ActionCompositeTests;
+
+	TestEqual(TEXT("Count runs the child that many times"), RunLog([](FFinishLog& Log) -> TSharedPtr<FAction>
+	{
+		return FAction_Repeat::CreateAction(FTestStep::CreateAction(TEXT("A"), 1, EActionResult::Success, Log), 3);
+	}), FString(TEXT("A:Success, A:Success, A:Success, Root:Success")));
+
+	TestEqual(TEXT("A failed iteration ends the repeat"), RunLog([](FFinishLog& Log) -> TSharedPtr<FAction>
+	{
+		TSharedPtr<FTestStep> Step = FTestStep::CreateAction(TEXT("A"), 1, EActionResult::Success, Log);
+		Step->RunResults = { EActionResult::Success, EActionResult::Fail };
+		return FAction_Repeat::CreateAction(Step, 5);
+	}), FString(TEXT("A:Success, A:Fail, Root:Fail")));
+
+	TestEqual(TEXT("A rearmed sequence replays every child"), RunLog([](FFinishLog& Log) -> TSharedPtr<FAction>
+	{
+		return FAction_Repeat::CreateAction(FAction_Sequence::CreateAction({ FTestStep::CreateAction(TEXT("A"), 1, EActionResult::Success, Log),
+			FTestStep::CreateAction(TEXT("B"), 0, EActionResult::Success, Log) }), 2);
+	}), FString(TEXT("A:Success, B:Success, A:Success, B:Success, Root:Success")));
+
+	TestEqual(TEXT("Until ends an unbounded repeat"), RunLog([](FFinishLog& Log) -> TSharedPtr<FAction>
+	{
+		TSharedPtr<FAction_Repeat> Repeat = FAction_Repeat::CreateAction(FTestStep::CreateAction(TEXT("A"), 1, EActionResult::Success, Log));
+		TSharedRef<int32> NumChecks = MakeShared<int32>(0);
+		Repeat->Until.BindLambda([NumChecks](FAction*) { return ++*NumChecks >= 2; });
+		return Repeat;
+	}), FString(TEXT("A:Success, A:Success, Root:Success")));
+
+	// An instant child goes past MaxInstantIterations, the rest of its iterations are left to the next ticks.
+	const int32 NumInstant = FAction_Repeat::MaxInstantIterations * 2 + 1;
+	FFinishLog Log;
+	{
+		FTestWorld TestWorld;
+		TestWorld.Run(FAction_Repeat::CreateAction(FTestStep::CreateAction(TEXT("A"), 0, EActionResult::Success, Log), NumInstant), Log);
+	}
+	TestEqual(TEXT("An instant child runs every iteration"), Log.Num(), NumInstant + 1);
+	TestEqual(TEXT("An instant child runs every iteration"), Log.Num() > 0 ? Log.Last() : FString(), FString(TEXT("Root:Success")));
+	return true;
+}
+
+/** FAction_Timeout fails its child once the deadline passes, woken by its timer even when nothing in the tree ticks. */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActionTimeoutTest, "ActionComponent.Composites.TimeoutFiring", ActionCompositeTests::TestFlags)
+
+bool FActionTimeoutTest::RunTest(const FString& Parameters)
+{
+	using namespace ActionCompositeTests;
+
+	TestEqual(TEXT("A child finishing in time keeps its result"), RunLog([](FFinishLog& Log) -> TSharedPtr<FAction>
+	{
+		return FAction_Timeout::CreateAction(FTestStep::CreateAction(TEXT("A"), 2, EActionResult::Success, Log), 10.0f);
+	}), FString(TEXT("A:Success, Root:Success")));
+
+	for (bool bEventDriven : { false, true })
+	{
+		const FString Label = bEventDriven ? TEXT("Event driven child") : TEXT("Ticking child");
+		FFinishLog Log;
+		FActionOutcome Outcome;
+		float Elapsed = 0.0f;
+		{
+			FTestWorld TestWorld;
+			TSharedPtr<FTestStep> Step = FTestStep::CreateAction(TEXT("A"), 1000, EActionResult::Success, Log);
+			Step->bEventDriven = bEventDriven;
+			Outcome = TestWorld.Run(FAction_Timeout::CreateAction(Step, 0.2f), Log);
+			Elapsed = TestWorld.World->GetTimeSeconds();
+		}
+		TestEqual(Label + TEXT(": finish order"), FString::Join(Log, TEXT(", ")), FString(TEXT("A:Abort, Root:Fail")));
+		TestTrue(Label + TEXT(": reason"), Outcome.Reason == EActionFinishReason::Timeout);
+		TestTrue(Label + TEXT(": fired at the deadline"), Elapsed >= 0.2f && Elapsed < 0.2f + 2.0f / 30.0f);
+	}
+	return true;
+}
+
+/** FAction_Race ends with its first finished child, whatever that child's result, and aborts the others. */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActionRaceWinnerTest, "ActionComponent.Composites.RaceWinner", ActionCompositeTests::TestFlags)
+
+bool FActionRaceWinnerTest::RunTest(const FString& Parameters)
+{
+	using namespace ActionCompositeTests;
+
+	TestEqual(TEXT("A successful winner"), RunLog([](FFinishLog& Log) -> TSharedPtr<FAction>
+	{
+		return FAction_Race::CreateAction({ FTestStep::CreateAction(TEXT("A"), 2, EActionResult::Success, Log), FTestStep::CreateAction(TEXT("B"), 4, EActionResult::Success, Log) });
+	}), FString(TEXT("A:Success, B:Abort, Root:Success")));
+
+	TestEqual(TEXT("A failing winner"), RunLog([](FFinishLog& Log) -> TSharedPtr<FAction>
+	{
+		return FAction_Race::CreateAction({ FTestStep::CreateAction(TEXT("A"), 3, EActionResult::Success, Log),
+			FTestStep::CreateAction(TEXT("B"), 1, EActionResult::Fail, Log), FTestStep::CreateAction(TEXT("C"), 5, EActionResult::Success, Log) });
+	}), FString(TEXT("B:Fail, A:Abort, C:Abort, Root:Fail")));
+
+	TestEqual(TEXT("An instant winner keeps the rest from starting"), RunLog([](FFinishLog& Log) -> TSharedPtr<FAction>
+	{
+		return FAction_Race::CreateAction({ FTestStep::CreateAction(TEXT("A"), 0, EActionResult::Success, Log), FTestStep::CreateAction(TEXT("B"), 3, EActionResult::Success, Log) });
+	}), FString(TEXT("A:Success, Root:Success")));
+	return true;
+}
+
+/** FAction_Retry reruns its child after failures only, up to its attempts, and waits out its backoff between them. */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActionRetryCountTest, "ActionComponent.Composites.RetryCounts", ActionCompositeTests::TestFlags)
+
+bool FActionRetryCountTest::RunTest(const FString& Parameters)
+{
+	using namespace ActionCompositeTests;
+
+	TestEqual(TEXT("Success ends the retries"), RunLog([](FFinishLog& Log) -> TSharedPtr<FAction>
+	{
+		TSharedPtr<FTestStep> Step = FTestStep::CreateAction(TEXT("A"), 1, EActionResult::Success, Log);
+		Step->RunResults = { EActionResult::Fail, EActionResult::Fail };
+		return FAction_Retry::CreateAction(Step, 5);
+	}), FString(TEXT("A:Fail, A:Fail, A:Success, Root:Success")));
+
+	TestEqual(TEXT("The last failed attempt fails the retry"), RunLog([](FFinishLog& Log) -> TSharedPtr<FAction>
+	{
+		return FAction_Retry::CreateAction(FTestStep::CreateAction(TEXT("A"), 0, EActionResult::Fail, Log), 3);
+	}), FString(TEXT("A:Fail, A:Fail, A:Fail, Root:Fail")));
+
+	TestEqual(TEXT("A first success is not retried"), RunLog([](FFinishLog& Log) -> TSharedPtr<FAction>
+	{
+		return FAction_Retry::CreateAction(FTestStep::CreateAction(TEXT("A"), 1, EActionResult::Success, Log), 3);
+	}), FString(TEXT("A:Success, Root:Success")));
+
+	// Backoff of 0.2s then 0.4s, so the third attempt cannot start before 0.6s.
+	FFinishLog Log;
+	float Elapsed = 0.0f;
+	{
+		FTestWorld TestWorld;
+		TestWorld.Run(FAction_Retry::CreateAction(FTestStep::CreateAction(TEXT("A"), 1, EActionResult::Fail, Log), 3, 0.2f, 2.0f), Log);
+		Elapsed = TestWorld.World->GetTimeSeconds();
+	}
+	TestEqual(TEXT("Backoff: finish order"), FString::Join(Log, TEXT(", ")), FString(TEXT("A:Fail, A:Fail, A:Fail, Root:Fail")));
+	TestTrue(TEXT("Backoff: waited between attempts"), Elapsed >= 0.6f);
+	return true;
+}
+
+/** FAction_Script resumes after each awaited action in order, stops on a failed ACTION_AWAIT and aborts what it awaits when stopped. */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActionScriptAwaitTest, "ActionComponent.Composites.ScriptAwaits", ActionCompositeTests::TestFlags)
+
+bool FActionScriptAwaitTest::RunTest(const FString& Parameters)
+{
+	using namespace ActionCompositeTests;
+
+	TestEqual(TEXT("Awaits run one after another"), RunLog([](FFinishLog& Log) -> TSharedPtr<FAction>
+	{
+		return FAction_Script::CreateAction([LogPtr = &Log](FActionScriptContext& Ctx) -> EActionResult
+		{
+			ACTION_SCRIPT_BEGIN(Ctx);
+			ACTION_AWAIT(Ctx, FTestStep::CreateAction(TEXT("A"), 1, EActionResult::Success, *LogPtr));
+			ACTION_AWAIT(Ctx, FTestStep::CreateAction(TEXT("B"), 0, EActionResult::Success, *LogPtr));
+			ACTION_AWAIT(Ctx, FTestStep::CreateAction(TEXT("C"), 2, EActionResult::Success, *LogPtr));
+			ACTION_SCRIPT_END(Ctx);
+		});
+	}), FString(TEXT("A:Success, B:Success, C:Success, Root:Success")));
+
+	TestEqual(TEXT("A failed await ends the script"), RunLog([](FFinishLog& Log) -> TSharedPtr<FAction>
+	{
+		return FAction_Script::CreateAction([LogPtr = &Log](FActionScriptContext& Ctx) -> EActionResult
+		{
+			ACTION_SCRIPT_BEGIN(Ctx);
+			ACTION_AWAIT(Ctx, FTestStep::CreateAction(TEXT("A"), 1, EActionResult::Success, *LogPtr));
+			ACTION_AWAIT(Ctx, FTestStep::CreateAction(TEXT("B"), 1, EActionResult::Fail, *LogPtr));
+			ACTION_AWAIT(Ctx, FTestStep::CreateAction(TEXT("C"), 1, EActionResult::Success, *LogPtr));
+			ACTION_SCRIPT_END(Ctx);
+		});
+	}), FString(TEXT("A:Success, B:Fail, Root:Fail")));
+
+	TestEqual(TEXT("ACTION_AWAIT_ANY resumes after a failure"), RunLog([](FFinishLog& Log) -> TSharedPtr<FAction>
+	{
+		return FAction_Script::CreateAction([LogPtr = &Log](FActionScriptContext& Ctx) -> EActionResult
+		{
+			ACTION_SCRIPT_BEGIN(Ctx);
+			ACTION_AWAIT_ANY(Ctx, FTestStep::CreateAction(TEXT("A"), 1, EActionResult::Fail, *LogPtr));
+			LogPtr->Add(FString::Printf(TEXT("Body:%s"), ResultToString(Ctx.LastResult)));
+			ACTION_AWAIT(Ctx, FTestStep::CreateAction(TEXT("C"), 1, EActionResult::Success, *LogPtr));
+			ACTION_SCRIPT_END(Ctx);
+		});
+	}), FString(TEXT("A:Fail, Body:Fail, C:Success, Root:Success")));
+
+	TestEqual(TEXT("A stopped script aborts the awaited action"), RunLog([](FFinishLog& Log) -> TSharedPtr<FAction>
+	{
+		TSharedPtr<FAction> Script = FAction_Script::CreateAction([LogPtr = &Log](FActionScriptContext& Ctx) -> EActionResult
+		{
+			ACTION_SCRIPT_BEGIN(Ctx);
+			ACTION_AWAIT(Ctx, FTestStep::CreateAction(TEXT("A"), 5, EActionResult::Success, *LogPtr));
+			ACTION_AWAIT(Ctx, FTestStep::CreateAction(TEXT("B"), 1, EActionResult::Success, *LogPtr));
+			ACTION_SCRIPT_END(Ctx);
+		});
+		return FAction_Race::CreateAction({ Script, FTestStep::CreateAction(TEXT("X"), 2, EActionResult::Success, Log) });
+	}), FString(TEXT("X:Success, A:Abort, Root:Success")));
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
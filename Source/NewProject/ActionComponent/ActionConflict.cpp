@@ -0,0 +1,44 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "ActionConflict.h"
+
+FActionConflictMatrix::FActionConflictMatrix()
+{
+	for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+	{
+		PreemptMasks[Channel] = 1ull << Channel;
+		QueueMasks[Channel] = 0;
+	}
+	SetPolicy((int32)EActionChannel::Animation, (int32)EActionChannel::Animation, EActionConflictPolicy::Coexist);
+}
+
+void FActionConflictMatrix::SetPolicy(int32 IncomingChannel, int32 RunningChannel, EActionConflictPolicy Policy)
+{
+	if (IncomingChannel < 0 || IncomingChannel >= NumChannels || RunningChannel < 0 || RunningChannel >= NumChannels)
+		return;
+
+	const uint64 Bit = 1ull << RunningChannel;
+	PreemptMasks[IncomingChannel] &= ~Bit;
+	QueueMasks[IncomingChannel] &= ~Bit;
+	if (Policy == EActionConflictPolicy::Preempt)
+	{
+		PreemptMasks[IncomingChannel] |= Bit;
+	}
+	else if (Policy == EActionConflictPolicy::Queue)
+	{
+		QueueMasks[IncomingChannel] |= Bit;
+	}
+}
+
+EActionConflictPolicy FActionConflictMatrix::GetPolicy(int32 IncomingChannel, int32 RunningChannel) const
+{
+	if (IncomingChannel < 0 || IncomingChannel >= NumChannels || RunningChannel < 0 || RunningChannel >= NumChannels)
+		return EActionConflictPolicy::Coexist;
+
+	const uint64 Bit = 1ull << RunningChannel;
+	if (PreemptMasks[IncomingChannel] & Bit)
+		return EActionConflictPolicy::Preempt;
+	if (QueueMasks[IncomingChannel] & Bit)
+		return EActionConflictPolicy::Queue;
+	return EActionConflictPolicy::Coexist;
+}
@@ -0,0 +1,93 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ActionEnums.h"
+#include "ActionConflict.generated.h"
+
+/** The named channels of EActionType, each value is the index of its bit. */
+UENUM(BlueprintType)
+enum class EActionChannel : uint8
+{
+	Move,
+	Rotate,
+	Animation,
+	Scale,
+	MeshMove,
+	MeshRotate,
+	MeshScale,
+	UpperBody,
+	LowerBody,
+	Facial,
+	Aim,
+	VFX,
+	Camera,
+
+	Max			UMETA(Hidden)
+};
+
+FORCEINLINE EActionType ActionChannelToType(EActionChannel Channel) { return EActionType(1ull << (uint8)Channel); }
+
+/** What executing an action does to a running action it shares a channel with. */
+UENUM(BlueprintType)
+enum class EActionConflictPolicy : uint8
+{
+	/** The running action is aborted. */
+	Preempt,
+	/** The new action waits until the running action has left the channel. */
+	Queue,
+	/** Both keep running. */
+	Coexist
+};
+
+USTRUCT()
+struct FActionConflictRule
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** Channel of the action being executed. */
+	UPROPERTY(EditAnywhere, Category = "Conflict")
+	EActionChannel Incoming = EActionChannel::Move;
+
+	/** Channel of the action already running. */
+	UPROPERTY(EditAnywhere, Category = "Conflict")
+	EActionChannel Running = EActionChannel::Move;
+
+	UPROPERTY(EditAnywhere, Category = "Conflict")
+	EActionConflictPolicy Policy = EActionConflictPolicy::Preempt;
+};
+
+/**
+ * Per incoming channel, the running channels it preempts and the ones it queues behind.
+ * By default every channel preempts itself and nothing else, except Animation which coexists and leaves
+ * montage arbitration to FAction_PlayAnimation.
+ */
+struct NEWPROJECT_API FActionConflictMatrix
+{
+	static const int32 NumChannels = 64;
+
+	FActionConflictMatrix();
+
+	void SetPolicy(int32 IncomingChannel, int32 RunningChannel, EActionConflictPolicy Policy);
+	EActionConflictPolicy GetPolicy(int32 IncomingChannel, int32 RunningChannel) const;
+
+	/** Channels whose running actions an action of InType aborts when it starts. */
+	FORCEINLINE EActionType GetPreemptedTypes(EActionType InType) const { return Gather(PreemptMasks, InType); }
+	/** Channels whose running actions an action of InType waits for before it starts. */
+	FORCEINLINE EActionType GetQueuingTypes(EActionType InType) const { return Gather(QueueMasks, InType); }
+
+private:
+	FORCEINLINE static EActionType Gather(const uint64* Masks, EActionType InType)
+	{
+		uint64 Result = 0;
+		for (uint64 Mask = (uint64)InType; Mask != 0; Mask &= Mask - 1)
+		{
+			Result |= Masks[LowestActionChannel(Mask)];
+		}
+		return (EActionType)Result;
+	}
+
+	uint64 PreemptMasks[NumChannels];
+	uint64 QueueMasks[NumChannels];
+};
@@ -1 +1,12 @@
 // Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "ActionEnums.h"
+
+namespace EActionFinishReason {
+	const FActionFinishReason UnKnown(TEXT("UnKnown"));
+	const FActionFinishReason UEInternalStop(TEXT("UEInternalStop"));
+	const FActionFinishReason CustomStop(TEXT("CustomStop"));
+	const FActionFinishReason Rejected(TEXT("Rejected"));
+	const FActionFinishReason QueueTimeout(TEXT("QueueTimeout"));
+	const FActionFinishReason Timeout(TEXT("Timeout"));
+};
@@ -2,11 +2,34 @@
 
 #pragma once
 #include "UnrealString.h"
+#include "UObject/NameTypes.h"
+
+/** Why an action finished, interned so passing, storing and comparing a reason never allocates. */
+struct FActionFinishReason
+{
+	FActionFinishReason() : Name(NAME_None) {}
+	FActionFinishReason(FName InName) : Name(InName) {}
+	FActionFinishReason(const TCHAR* InName) : Name(InName) {}
+	/** Compatibility with callers still building reasons as strings. */
+	FActionFinishReason(const FString& InName) : Name(*InName) {}
+
+	FORCEINLINE FName GetName() const { return Name; }
+	FORCEINLINE FString ToString() const { return Name.ToString(); }
+
+	FORCEINLINE bool operator==(const FActionFinishReason& Other) const { return Name == Other.Name; }
+	FORCEINLINE bool operator!=(const FActionFinishReason& Other) const { return Name != Other.Name; }
+
+private:
+	FName Name;
+};
 
 namespace EActionFinishReason {
-	const static FString UnKnown(TEXT("UnKnown"));
-	const static FString UEInternalStop(TEXT("UEInternalStop"));
-	const static FString CustomStop(TEXT("CustomStop"));
+	extern NEWPROJECT_API const FActionFinishReason UnKnown;
+	extern NEWPROJECT_API const FActionFinishReason UEInternalStop;
+	extern NEWPROJECT_API const FActionFinishReason CustomStop;
+	extern NEWPROJECT_API const FActionFinishReason Rejected;
+	extern NEWPROJECT_API const FActionFinishReason QueueTimeout;
+	extern NEWPROJECT_API const FActionFinishReason Timeout;
 };
 
 UENUM(BlueprintType)
@@ -32,7 +55,8 @@ enum class EActionResult : uint8
 	Clean
 };
 
-enum class EActionType
+/** A set of up to 64 channels, an action conflicts with the running actions sharing a channel with it as configured by FActionConflictMatrix. */
+enum class EActionType : uint64
 {
 	Default		= 0x0000,
 	Move		= 0x0001,
@@ -41,11 +65,24 @@ enum class EActionType
 	Scale		= 0x0008,
 	MeshMove	= 0x0010,
 	MeshRotate  = 0x0020,
-	MeshScale	= 0x0040
+	MeshScale	= 0x0040,
+	UpperBody	= 0x0080,
+	LowerBody	= 0x0100,
+	Facial		= 0x0200,
+	Aim			= 0x0400,
+	VFX			= 0x0800,
+	Camera		= 0x1000
 };
 
-FORCEINLINE EActionType operator|(EActionType Arg1, EActionType Arg2) { return EActionType(uint32(Arg1) | uint32(Arg2)); }
-FORCEINLINE EActionType operator&(EActionType Arg1, EActionType Arg2) { return EActionType(uint32(Arg1) & uint32(Arg2)); }
+FORCEINLINE EActionType operator|(EActionType Arg1, EActionType Arg2) { return EActionType(uint64(Arg1) | uint64(Arg2)); }
+FORCEINLINE EActionType operator&(EActionType Arg1, EActionType Arg2) { return EActionType(uint64(Arg1) & uint64(Arg2)); }
+FORCEINLINE EActionType operator~(EActionType Arg) { return EActionType(~uint64(Arg)); }
 FORCEINLINE void operator&=(EActionType &Dest, EActionType Arg) { Dest = EActionType(Dest & Arg); }
 FORCEINLINE void operator|=(EActionType &Dest, EActionType Arg) { Dest = EActionType(Dest | Arg); }
 
+/** Index of the lowest channel set in a non-empty channel mask. */
+FORCEINLINE int32 LowestActionChannel(uint64 Mask)
+{
+	const uint32 Low = (uint32)Mask;
+	return Low != 0 ? (int32)FMath::CountTrailingZeros(Low) : 32 + (int32)FMath::CountTrailingZeros((uint32)(Mask >> 32));
+}
@@ -0,0 +1,216 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "ActionFloorTraceBatch.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "ActionStats.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Async Floor Traces"), STAT_ActionAsyncFloorTraces, STATGROUP_ActionComponent);
+DECLARE_CYCLE_STAT(TEXT("Dispatch Floor Traces"), STAT_ActionDispatchFloorTraces, STATGROUP_ActionComponent);
+
+static TAutoConsoleVariable<int32> CVarActionAsyncFloorTraces(
+	TEXT("ActionComponent.AsyncFloorTraces"),
+	0,
+	TEXT("When non-zero, FAction_ServerMoveTo sweeps for the floor through the async trace API and keeps following the last known floor until the result is back."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarActionMaxAsyncFloorTraces(
+	TEXT("ActionComponent.MaxAsyncFloorTraces"),
+	256,
+	TEXT("Floor sweeps sent per world and frame when ActionComponent.AsyncFloorTraces is set, the others are sent on later frames."),
+	ECVF_Default);
+
+TMap<TWeakObjectPtr<UWorld>, TSharedPtr<FActionFloorTraceBatch>> FActionFloorTraceBatch::Batches;
+
+bool FActionFloorTraceBatch::IsEnabled()
+{
+	return CVarActionAsyncFloorTraces.GetValueOnGameThread() != 0;
+}
+
+FActionFloorTraceBatch* FActionFloorTraceBatch::Get(UWorld* World, bool bCreateIfMissing /*= true*/)
+{
+	if (!World)
+		return nullptr;
+
+	if (TSharedPtr<FActionFloorTraceBatch>* Found = Batches.Find(World))
+	{
+		return Found->Get();
+	}
+	if (!bCreateIfMissing)
+		return nullptr;
+
+	static bool bBoundWorldDelegates = false;
+	if (!bBoundWorldDelegates)
+	{
+		bBoundWorldDelegates = true;
+		FWorldDelegates::OnWorldPostActorTick.AddStatic(&FActionFloorTraceBatch::OnWorldPostActorTick);
+		FWorldDelegates::OnWorldCleanup.AddStatic(&FActionFloorTraceBatch::OnWorldCleanup);
+	}
+
+	TSharedPtr<FActionFloorTraceBatch> Batch = MakeShared<FActionFloorTraceBatch>();
+	Batch->World = World;
+	Batches.Add(World, Batch);
+	return Batch.Get();
+}
+
+void FActionFloorTraceBatch::OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaTime)
+{
+	if (FActionFloorTraceBatch* Batch = Get(World, false))
+	{
+		Batch->Dispatch();
+	}
+}
+
+void FActionFloorTraceBatch::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	Batches.Remove(World);
+}
+
+void FActionFloorTraceBatch::RequestFloor(UCharacterMovementComponent* Movement, const FVector& Location)
+{
+	if (!Movement)
+		return;
+
+	if (FFloorQuery* Query = Queries.Find(Movement))
+	{
+		if (!Query->IsSent())
+		{
+			Query->Location = Location;
+		}
+		return;
+	}
+
+	FFloorQuery& Query = Queries.Add(Movement);
+	Query.Location = Location;
+	Query.SweepDistance = 0.0f;
+	Query.PawnRadius = 0.0f;
+	Pending.Add(Movement);
+}
+
+bool FActionFloorTraceBatch::ConsumeFloor(UCharacterMovementComponent* Movement, FFindFloorResult& OutFloor, FVector& OutLocation)
+{
+	FFloorQuery* Query = Queries.Find(Movement);
+	if (!Query || !Query->IsSent())
+		return false;
+
+	FHitResult Hit;
+	if (!QuerySweep(Query->Sweeps[0], Hit))
+		return false;
+
+	// Same acceptance as ComputeFloorDist: a hit against the side of the capsule or one starting in penetration falls
+	// back to the narrower sweep, and negative distances are kept so the capsule can be pulled out.
+	const FFloorSweep* Sweep = &Query->Sweeps[0];
+	if (Hit.bBlockingHit && (Hit.bStartPenetrating || !IsWithinEdgeTolerance(Query->Location, Hit.ImpactPoint, Sweep->Radius)) && Query->Sweeps[1].Handle.IsValid())
+	{
+		Sweep = &Query->Sweeps[1];
+		if (!QuerySweep(*Sweep, Hit))
+			return false;
+	}
+
+	OutFloor.Clear();
+	if (Hit.bBlockingHit)
+	{
+		const float MaxPenetrationAdjust = FMath::Max(UCharacterMovementComponent::MAX_FLOOR_DIST, Query->PawnRadius);
+		const float SweepResult = FMath::Max(-MaxPenetrationAdjust, Hit.Time * Sweep->TraceDist - Sweep->ShrinkHeight);
+		OutFloor.SetFromSweep(Hit, SweepResult, false);
+		OutFloor.bWalkableFloor = Hit.IsValidBlockingHit() && Movement->IsWalkable(Hit) && SweepResult <= Query->SweepDistance;
+	}
+	OutLocation = Query->Location;
+	Queries.Remove(Movement);
+	return true;
+}
+
+bool FActionFloorTraceBatch::QuerySweep(const FFloorSweep& Sweep, FHitResult& OutHit) const
+{
+	FTraceDatum Datum;
+	if (!World->QueryTraceData(Sweep.Handle, Datum))
+		return false;
+
+	OutHit = FHitResult(1.0f);
+	for (const FHitResult& Hit : Datum.OutHits)
+	{
+		if (Hit.bBlockingHit)
+		{
+			OutHit = Hit;
+			break;
+		}
+	}
+	return true;
+}
+
+bool FActionFloorTraceBatch::IsWithinEdgeTolerance(const FVector& CapsuleLocation, const FVector& ImpactPoint, float CapsuleRadius)
+{
+	const float DistFromCenterSq = (ImpactPoint - CapsuleLocation).SizeSquared2D();
+	const float ReducedRadius = FMath::Max(UCharacterMovementComponent::SWEEP_EDGE_REJECT_DISTANCE + KINDA_SMALL_NUMBER, CapsuleRadius - UCharacterMovementComponent::SWEEP_EDGE_REJECT_DISTANCE);
+	return DistFromCenterSq < FMath::Square(ReducedRadius);
+}
+
+void FActionFloorTraceBatch::CancelFloor(UCharacterMovementComponent* Movement)
+{
+	Queries.Remove(Movement);
+}
+
+void FActionFloorTraceBatch::Dispatch()
+{
+	SCOPE_CYCLE_COUNTER(STAT_ActionDispatchFloorTraces);
+
+	// Results are kept for one frame only, drop the queries whose owner never came back for them.
+	for (auto It = Queries.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid() || (It.Value().IsSent() && !World->IsTraceHandleValid(It.Value().Sweeps[0].Handle, false)))
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	const int32 MaxTraces = CVarActionMaxAsyncFloorTraces.GetValueOnGameThread();
+	int32 NumSent = 0;
+	int32 NumTaken = 0;
+	for (; NumTaken < Pending.Num() && NumSent < MaxTraces; ++NumTaken)
+	{
+		UCharacterMovementComponent* Movement = Pending[NumTaken].Get();
+		FFloorQuery* Query = Movement ? Queries.Find(Movement) : nullptr;
+		UCapsuleComponent* Capsule = Movement && Movement->GetCharacterOwner() ? Movement->GetCharacterOwner()->GetCapsuleComponent() : nullptr;
+		if (!Query || Query->IsSent() || !Capsule)
+			continue;
+
+		// Same reach as the synchronous check, which the action runs with a step height of the capsule height.
+		float PawnRadius = 0.0f;
+		float PawnHalfHeight = 0.0f;
+		Capsule->GetScaledCapsuleSize(PawnRadius, PawnHalfHeight);
+		const float HeightCheckAdjust = Movement->IsMovingOnGround() ? UCharacterMovementComponent::MAX_FLOOR_DIST + KINDA_SMALL_NUMBER : -UCharacterMovementComponent::MAX_FLOOR_DIST;
+		Query->SweepDistance = FMath::Max(UCharacterMovementComponent::MAX_FLOOR_DIST, PawnHalfHeight * 2.0f + HeightCheckAdjust);
+		Query->PawnRadius = PawnRadius;
+
+		FCollisionQueryParams Params(SCENE_QUERY_STAT(ActionFloorTrace), false, Movement->GetOwner());
+		FCollisionResponseParams ResponseParams;
+		Capsule->InitSweepCollisionParams(Params, ResponseParams);
+
+		// The shrink scales of ComputeFloorDist, the second sweep is also narrowed to clear walls next to the capsule.
+		const float ShrinkScales[2] = { 0.9f, 0.1f };
+		for (int32 SweepIndex = 0; SweepIndex < 2; ++SweepIndex)
+		{
+			FFloorSweep& Sweep = Query->Sweeps[SweepIndex];
+			Sweep.Radius = SweepIndex == 0 ? PawnRadius : FMath::Max(0.0f, PawnRadius - UCharacterMovementComponent::SWEEP_EDGE_REJECT_DISTANCE - KINDA_SMALL_NUMBER);
+			Sweep.ShrinkHeight = (PawnHalfHeight - PawnRadius) * (1.0f - ShrinkScales[SweepIndex]);
+			Sweep.TraceDist = Query->SweepDistance + Sweep.ShrinkHeight;
+			const float SweepHalfHeight = SweepIndex == 0 ? PawnHalfHeight - Sweep.ShrinkHeight : FMath::Max(PawnHalfHeight - Sweep.ShrinkHeight, Sweep.Radius);
+			const FCollisionShape Shape = FCollisionShape::MakeCapsule(Sweep.Radius, SweepHalfHeight);
+			if (SweepIndex > 0 && Shape.IsNearlyZero())
+			{
+				Sweep.Handle = FTraceHandle();
+				continue;
+			}
+
+			const FVector End = Query->Location - FVector(0.0f, 0.0f, Sweep.TraceDist);
+			Sweep.Handle = World->AsyncSweepByChannel(EAsyncTraceType::Single, Query->Location, End, FQuat::Identity, Capsule->GetCollisionObjectType(),
+				Shape, Params, ResponseParams);
+			++NumSent;
+		}
+	}
+	Pending.RemoveAt(0, NumTaken, false);
+	INC_DWORD_STAT_BY(STAT_ActionAsyncFloorTraces, NumSent);
+}
@@ -0,0 +1,72 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "WorldCollision.h"
+
+class UWorld;
+class UCharacterMovementComponent;
+struct FFindFloorResult;
+
+/**
+ * Floor sweeps of the server-driven movers of a world, sent together through the async trace API once actors have ticked.
+ * At most ActionComponent.MaxAsyncFloorTraces are sent per frame, the rest wait for the next one, and a result is
+ * read back the frame after it was sent. Opt-in through ActionComponent.AsyncFloorTraces.
+ * Each request mirrors UCharacterMovementComponent::ComputeFloorDist, so its narrower retry sweep is sent alongside
+ * the first one instead of after it.
+ */
+class NEWPROJECT_API FActionFloorTraceBatch
+{
+public:
+	static bool IsEnabled();
+
+	static FActionFloorTraceBatch* Get(UWorld* World, bool bCreateIfMissing = true);
+
+	/** Queues a floor sweep below Movement's capsule centred at Location, replacing one of Movement's not sent yet. */
+	void RequestFloor(UCharacterMovementComponent* Movement, const FVector& Location);
+	/** Takes the result of Movement's last request once it is back, OutLocation is where it was made. */
+	bool ConsumeFloor(UCharacterMovementComponent* Movement, FFindFloorResult& OutFloor, FVector& OutLocation);
+	void CancelFloor(UCharacterMovementComponent* Movement);
+
+protected:
+	/** One capsule sweep down from the query location, shrunk by ShrinkHeight and TraceDist long. */
+	struct FFloorSweep
+	{
+		FTraceHandle Handle;
+		float Radius;
+		float ShrinkHeight;
+		float TraceDist;
+	};
+
+	struct FFloorQuery
+	{
+		FVector Location;
+		/** The regular sweep, then the narrower one used when it hits an adjacent wall or starts penetrating. */
+		FFloorSweep Sweeps[2];
+		/** Floors further than this below the capsule are not walkable. */
+		float SweepDistance;
+		float PawnRadius;
+
+		/** False until the query is sent. */
+		bool IsSent() const { return Sweeps[0].Handle.IsValid(); }
+	};
+
+	bool QuerySweep(const FFloorSweep& Sweep, FHitResult& OutHit) const;
+
+	static bool IsWithinEdgeTolerance(const FVector& CapsuleLocation, const FVector& ImpactPoint, float CapsuleRadius);
+
+	void Dispatch();
+
+	static void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaTime);
+	static void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+
+	UWorld* World = nullptr;
+
+	TMap<TWeakObjectPtr<UCharacterMovementComponent>, FFloorQuery> Queries;
+	/** Queries not sent yet, oldest first. */
+	TArray<TWeakObjectPtr<UCharacterMovementComponent>> Pending;
+
+	static TMap<TWeakObjectPtr<UWorld>, TSharedPtr<FActionFloorTraceBatch>> Batches;
+};
@@ -0,0 +1,365 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "ActionGraphAsset.h"
+#include "JsonObjectConverter.h"
+#include "Animation/AnimMontage.h"
+#include "Curves/CurveBase.h"
+#include "Action_Sequence.h"
+#include "Action_Parallel.h"
+#include "Action_Repeat.h"
+#include "Action_Wait.h"
+#include "Action_PlayAnimation.h"
+#include "Action_PlayRootMotion.h"
+#include "Action_InterpMoveTo.h"
+#include "Action_SimpleMoveTo.h"
+
+DEFINE_LOG_CATEGORY(LogActionGraph);
+
+namespace
+{
+	const uint32 ActionGraphMagic = 0x42524741;
+	const uint32 ActionGraphVersion = 2;
+
+	struct FActionGraphBlobHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		int32 NumNodes;
+		int32 NumChildIndices;
+	};
+
+	enum EActionGraphBlobFlags : uint8
+	{
+		StopSeparateType = 1 << 0,
+		Looping = 1 << 1,
+		NonBlocking = 1 << 2,
+		WithControl = 1 << 3,
+		UsePathfinding = 1 << 4
+	};
+
+	/** Cooked form of FActionGraphNode, objects and names are indices into the asset's tables. */
+	struct FActionGraphBlobNode
+	{
+		uint8 Kind;
+		uint8 JoinPolicy;
+		uint8 AnimationPriority;
+		uint8 Flags;
+		int32 FirstChild;
+		int32 NumChildren;
+		int32 RequiredCount;
+		int32 RepeatCount;
+		int32 ActionPriority;
+		int32 Animation;
+		int32 Curve;
+		int32 SlotNodeName;
+		float QueueTimeout;
+		float Duration;
+		float PlayRate;
+		float BlendInTime;
+		float BlendOutTime;
+		float MaxSpeed;
+		float AcceptanceRadius;
+		float Location[3];
+	};
+
+	const FActionGraphBlobHeader* GetBlobHeader(const TArray<uint8>& Blob)
+	{
+		if (Blob.Num() < (int32)sizeof(FActionGraphBlobHeader))
+			return nullptr;
+
+		const FActionGraphBlobHeader* Header = reinterpret_cast<const FActionGraphBlobHeader*>(Blob.GetData());
+		if (Header->Magic != ActionGraphMagic || Header->Version != ActionGraphVersion)
+			return nullptr;
+		if (Blob.Num() != sizeof(FActionGraphBlobHeader) + Header->NumNodes * sizeof(FActionGraphBlobNode) + Header->NumChildIndices * sizeof(int32))
+			return nullptr;
+		return Header;
+	}
+}
+
+#if WITH_EDITOR
+bool UActionGraphAsset::ImportFromJson(const FString& InJson, FString& OutError)
+{
+	TArray<FActionGraphNode> ImportedNodes;
+	if (!FJsonObjectConverter::JsonArrayStringToUStruct(InJson, &ImportedNodes, 0, 0))
+	{
+		OutError = TEXT("Not a JSON array of action graph nodes");
+		return false;
+	}
+
+	Modify();
+	Nodes = MoveTemp(ImportedNodes);
+	return Cook(OutError);
+}
+
+bool UActionGraphAsset::Validate(FString& OutError) const
+{
+	if (Nodes.Num() == 0)
+	{
+		OutError = TEXT("Graph has no nodes");
+		return false;
+	}
+
+	TArray<int32> Parents;
+	Parents.Init(INDEX_NONE, Nodes.Num());
+	for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+	{
+		const FActionGraphNode& Node = Nodes[Index];
+		const bool bComposite = Node.Kind == EActionGraphNodeKind::Sequence || Node.Kind == EActionGraphNodeKind::Parallel || Node.Kind == EActionGraphNodeKind::Repeat;
+		if (!bComposite && Node.Children.Num() > 0)
+		{
+			OutError = FString::Printf(TEXT("Node %d is a leaf but has children"), Index);
+			return false;
+		}
+		if (Node.Kind == EActionGraphNodeKind::Parallel && Node.Children.Num() == 0)
+		{
+			OutError = FString::Printf(TEXT("Parallel node %d has no children"), Index);
+			return false;
+		}
+		if (Node.Kind == EActionGraphNodeKind::Repeat && Node.Children.Num() != 1)
+		{
+			OutError = FString::Printf(TEXT("Repeat node %d must have exactly one child"), Index);
+			return false;
+		}
+		if ((Node.Kind == EActionGraphNodeKind::PlayAnimation || Node.Kind == EActionGraphNodeKind::PlayRootMotion) && Node.Animation.IsNull())
+		{
+			OutError = FString::Printf(TEXT("Node %d has no animation"), Index);
+			return false;
+		}
+
+		for (int32 Child : Node.Children)
+		{
+			if (Child <= 0 || Child >= Nodes.Num())
+			{
+				OutError = FString::Printf(TEXT("Node %d has invalid child %d"), Index, Child);
+				return false;
+			}
+			if (Parents[Child] != INDEX_NONE)
+			{
+				OutError = FString::Printf(TEXT("Node %d is a child of both node %d and node %d"), Child, Parents[Child], Index);
+				return false;
+			}
+			Parents[Child] = Index;
+		}
+	}
+
+	// With a single parent per node, every node is reachable from the root unless it sits on a cycle or has no parent.
+	for (int32 Index = 1; Index < Nodes.Num(); ++Index)
+	{
+		int32 Ancestor = Index;
+		int32 Depth = 0;
+		while (Ancestor > 0 && Depth++ < Nodes.Num())
+		{
+			Ancestor = Parents[Ancestor];
+		}
+		if (Ancestor != 0)
+		{
+			OutError = FString::Printf(TEXT("Node %d is not reachable from the root"), Index);
+			return false;
+		}
+	}
+	return true;
+}
+
+bool UActionGraphAsset::Cook(FString& OutError)
+{
+	if (!Validate(OutError))
+		return false;
+
+	TArray<UObject*> Objects;
+	TArray<FName> Names;
+	TArray<FActionGraphBlobNode> BlobNodes;
+	TArray<int32> ChildIndices;
+	BlobNodes.SetNumZeroed(Nodes.Num());
+	for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+	{
+		const FActionGraphNode& Node = Nodes[Index];
+		FActionGraphBlobNode& BlobNode = BlobNodes[Index];
+
+		UAnimationAsset* Animation = Node.Animation.LoadSynchronous();
+		if (Node.Kind == EActionGraphNodeKind::PlayRootMotion && !Cast<UAnimMontage>(Animation))
+		{
+			OutError = FString::Printf(TEXT("Node %d plays root motion from %s, which is not a montage"), Index, *Node.Animation.ToString());
+			return false;
+		}
+		UCurveBase* Curve = Node.Curve.LoadSynchronous();
+
+		BlobNode.Kind = (uint8)Node.Kind;
+		BlobNode.JoinPolicy = (uint8)Node.JoinPolicy;
+		BlobNode.AnimationPriority = (uint8)Node.AnimationPriority;
+		BlobNode.Flags = (Node.bStopSeparateType ? StopSeparateType : 0)
+			| (Node.bLooping ? Looping : 0)
+			| (Node.bNonBlocking ? NonBlocking : 0)
+			| (Node.bWithControl ? WithControl : 0)
+			| (Node.bUsePathfinding ? UsePathfinding : 0);
+		BlobNode.FirstChild = ChildIndices.Num();
+		BlobNode.NumChildren = Node.Children.Num();
+		ChildIndices.Append(Node.Children);
+		BlobNode.RequiredCount = Node.RequiredCount;
+		BlobNode.RepeatCount = Node.RepeatCount;
+		BlobNode.ActionPriority = Node.ActionPriority;
+		BlobNode.Animation = Animation ? Objects.AddUnique(Animation) : INDEX_NONE;
+		BlobNode.Curve = Curve ? Objects.AddUnique(Curve) : INDEX_NONE;
+		BlobNode.SlotNodeName = Node.SlotNodeName.IsNone() ? INDEX_NONE : Names.AddUnique(Node.SlotNodeName);
+		BlobNode.QueueTimeout = Node.QueueTimeout;
+		BlobNode.Duration = Node.Duration;
+		BlobNode.PlayRate = Node.PlayRate;
+		BlobNode.BlendInTime = Node.BlendInTime;
+		BlobNode.BlendOutTime = Node.BlendOutTime;
+		BlobNode.MaxSpeed = Node.MaxSpeed;
+		BlobNode.AcceptanceRadius = Node.AcceptanceRadius;
+		BlobNode.Location[0] = Node.Location.X;
+		BlobNode.Location[1] = Node.Location.Y;
+		BlobNode.Location[2] = Node.Location.Z;
+	}
+
+	FActionGraphBlobHeader Header;
+	Header.Magic = ActionGraphMagic;
+	Header.Version = ActionGraphVersion;
+	Header.NumNodes = BlobNodes.Num();
+	Header.NumChildIndices = ChildIndices.Num();
+
+	CookedData.Reset(sizeof(Header) + BlobNodes.Num() * sizeof(FActionGraphBlobNode) + ChildIndices.Num() * sizeof(int32));
+	CookedData.Append(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+	CookedData.Append(reinterpret_cast<const uint8*>(BlobNodes.GetData()), BlobNodes.Num() * sizeof(FActionGraphBlobNode));
+	CookedData.Append(reinterpret_cast<const uint8*>(ChildIndices.GetData()), ChildIndices.Num() * sizeof(int32));
+	CookedObjects = MoveTemp(Objects);
+	CookedNames = MoveTemp(Names);
+	Prototype = FActionPrototype();
+	return true;
+}
+
+void UActionGraphAsset::Recook()
+{
+	FString Error;
+	if (!Cook(Error))
+	{
+		UE_LOG(LogActionGraph, Warning, TEXT("%s could not be cooked: %s"), *GetPathName(), *Error);
+		CookedData.Empty();
+		CookedObjects.Empty();
+		CookedNames.Empty();
+		Prototype = FActionPrototype();
+	}
+}
+#endif
+
+bool UActionGraphAsset::IsCooked() const
+{
+	return GetBlobHeader(CookedData) != nullptr;
+}
+
+TSharedPtr<FAction> UActionGraphAsset::Instantiate() const
+{
+	const FActionGraphBlobHeader* Header = GetBlobHeader(CookedData);
+	if (!Header || Header->NumNodes == 0)
+		return nullptr;
+	return InstantiateNode(CookedData.GetData(), 0);
+}
+
+TSharedPtr<FAction> UActionGraphAsset::SpawnAction()
+{
+	if (!Prototype.IsValid())
+	{
+		TSharedPtr<FAction> Root = Instantiate();
+		if (!Root.IsValid())
+			return nullptr;
+		Prototype = FActionPrototype(Root);
+	}
+	return Prototype.Spawn();
+}
+
+TSharedPtr<FAction> UActionGraphAsset::InstantiateNode(const uint8* Blob, int32 Index) const
+{
+	const FActionGraphBlobHeader& Header = *reinterpret_cast<const FActionGraphBlobHeader*>(Blob);
+	const FActionGraphBlobNode* BlobNodes = reinterpret_cast<const FActionGraphBlobNode*>(Blob + sizeof(FActionGraphBlobHeader));
+	const int32* ChildIndices = reinterpret_cast<const int32*>(BlobNodes + Header.NumNodes);
+	const FActionGraphBlobNode& Node = BlobNodes[Index];
+
+	UObject* Animation = CookedObjects.IsValidIndex(Node.Animation) ? CookedObjects[Node.Animation] : nullptr;
+	UObject* Curve = CookedObjects.IsValidIndex(Node.Curve) ? CookedObjects[Node.Curve] : nullptr;
+	const FName SlotNodeName = CookedNames.IsValidIndex(Node.SlotNodeName) ? CookedNames[Node.SlotNodeName] : NAME_None;
+	const FVector Location(Node.Location[0], Node.Location[1], Node.Location[2]);
+
+	TSharedPtr<FAction> Action;
+	switch ((EActionGraphNodeKind)Node.Kind)
+	{
+	case EActionGraphNodeKind::Sequence:
+	case EActionGraphNodeKind::Parallel:
+	{
+		TArray<TSharedPtr<FAction>> Children;
+		Children.Reserve(Node.NumChildren);
+		for (int32 Child = 0; Child < Node.NumChildren; ++Child)
+		{
+			Children.Add(InstantiateNode(Blob, ChildIndices[Node.FirstChild + Child]));
+		}
+		if ((EActionGraphNodeKind)Node.Kind == EActionGraphNodeKind::Sequence)
+		{
+			Action = FAction_Sequence::CreateAction(Children);
+		}
+		else
+		{
+			TSharedPtr<FAction_Parallel> Parallel = FAction_Parallel::CreateAction(Children, (EActionJoinPolicy)Node.JoinPolicy, Node.RequiredCount);
+			Parallel->bStopSeparateType = (Node.Flags & StopSeparateType) != 0;
+			Action = Parallel;
+		}
+		break;
+	}
+	case EActionGraphNodeKind::Repeat:
+		Action = FAction_Repeat::CreateAction(InstantiateNode(Blob, ChildIndices[Node.FirstChild]), Node.RepeatCount);
+		break;
+	case EActionGraphNodeKind::Wait:
+		Action = FAction_Wait::CreateAction(Node.Duration);
+		break;
+	case EActionGraphNodeKind::PlayAnimation:
+		Action = FAction_PlayAnimation::CreateAction(Cast<UAnimationAsset>(Animation), Node.PlayRate, Node.BlendInTime, Node.BlendOutTime, (Node.Flags & Looping) != 0, (EAction_AnimationPriority)Node.AnimationPriority, SlotNodeName, (Node.Flags & NonBlocking) != 0);
+		break;
+	case EActionGraphNodeKind::PlayRootMotion:
+		Action = FAction_PlayRootMotion::CreateAction(Cast<UAnimMontage>(Animation), Node.PlayRate, Node.BlendInTime, Node.BlendOutTime, (Node.Flags & Looping) != 0, SlotNodeName, (Node.Flags & NonBlocking) != 0);
+		break;
+	case EActionGraphNodeKind::InterpMoveTo:
+		Action = FAction_InterpMoveTo::CreateAction(Location, Node.Duration, Cast<UCurveBase>(Curve), (Node.Flags & WithControl) != 0);
+		break;
+	case EActionGraphNodeKind::SimpleMoveTo:
+		Action = FAction_SimpleMoveTo::CreateAction(Location, Node.MaxSpeed, Node.AcceptanceRadius, (Node.Flags & UsePathfinding) != 0);
+		break;
+	}
+
+	if (Action.IsValid())
+	{
+		Action->ActionPriority = Node.ActionPriority;
+		Action->QueueTimeout = Node.QueueTimeout;
+	}
+	return Action;
+}
+
+void UActionGraphAsset::PostLoad()
+{
+	Super::PostLoad();
+
+	bLoadedCooked = IsCooked();
+	if (bLoadedCooked)
+		return;
+
+#if WITH_EDITOR
+	if (Nodes.Num() > 0)
+	{
+		Recook();
+	}
+#else
+	// Cooking loads what the nodes reference, which must not happen from PostLoad outside the editor.
+	UE_LOG(LogActionGraph, Error, TEXT("%s has no cooked data, resave it in the editor"), *GetPathName());
+#endif
+}
+
+#if WITH_EDITOR
+void UActionGraphAsset::PreSave(const class ITargetPlatform* TargetPlatform)
+{
+	Super::PreSave(TargetPlatform);
+	Recook();
+}
+
+void UActionGraphAsset::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	Recook();
+}
+#endif
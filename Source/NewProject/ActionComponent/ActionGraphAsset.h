@@ -0,0 +1,184 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "ActionEnums.h"
+#include "ActionPrototype.h"
+#include "ActionGraphAsset.generated.h"
+
+class UAnimationAsset;
+class UCurveBase;
+
+NEWPROJECT_API DECLARE_LOG_CATEGORY_EXTERN(LogActionGraph, Log, All);
+
+UENUM(BlueprintType)
+enum class EActionGraphNodeKind : uint8
+{
+	Sequence,
+	Parallel,
+	Repeat,
+	Wait,
+	PlayAnimation,
+	PlayRootMotion,
+	InterpMoveTo,
+	SimpleMoveTo
+};
+
+/** Mirrors EActionJoinPolicy. */
+UENUM(BlueprintType)
+enum class EActionGraphJoinPolicy : uint8
+{
+	All,
+	Any,
+	Major,
+	NOfM
+};
+
+/** One node of an action graph, only the properties of its Kind are read. */
+USTRUCT(BlueprintType)
+struct FActionGraphNode
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Node")
+	EActionGraphNodeKind Kind = EActionGraphNodeKind::Wait;
+
+	/** Indices of the children of a Sequence, Parallel or Repeat in the graph's Nodes, a Repeat has exactly one. */
+	UPROPERTY(EditAnywhere, Category = "Node")
+	TArray<int32> Children;
+
+	UPROPERTY(EditAnywhere, Category = "Node")
+	int32 ActionPriority = 0;
+
+	UPROPERTY(EditAnywhere, Category = "Node")
+	float QueueTimeout = 0.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Parallel")
+	EActionGraphJoinPolicy JoinPolicy = EActionGraphJoinPolicy::All;
+
+	UPROPERTY(EditAnywhere, Category = "Parallel")
+	int32 RequiredCount = 1;
+
+	UPROPERTY(EditAnywhere, Category = "Parallel")
+	bool bStopSeparateType = false;
+
+	/** Iterations of a Repeat, zero or less repeats until the child fails. */
+	UPROPERTY(EditAnywhere, Category = "Repeat")
+	int32 RepeatCount = 0;
+
+	/** Delay of a Wait, duration of an InterpMoveTo. */
+	UPROPERTY(EditAnywhere, Category = "Leaf")
+	float Duration = 0.0f;
+
+	/** Played by PlayAnimation, must be a montage for PlayRootMotion. */
+	UPROPERTY(EditAnywhere, Category = "Animation")
+	TSoftObjectPtr<UAnimationAsset> Animation;
+
+	UPROPERTY(EditAnywhere, Category = "Animation")
+	float PlayRate = 1.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Animation")
+	float BlendInTime = -1.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Animation")
+	float BlendOutTime = -1.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Animation")
+	bool bLooping = false;
+
+	UPROPERTY(EditAnywhere, Category = "Animation")
+	bool bNonBlocking = false;
+
+	UPROPERTY(EditAnywhere, Category = "Animation")
+	EAction_AnimationPriority AnimationPriority = EAction_AnimationPriority::Normal;
+
+	UPROPERTY(EditAnywhere, Category = "Animation")
+	FName SlotNodeName;
+
+	UPROPERTY(EditAnywhere, Category = "Move")
+	FVector Location = FVector::ZeroVector;
+
+	UPROPERTY(EditAnywhere, Category = "Move")
+	TSoftObjectPtr<UCurveBase> Curve;
+
+	UPROPERTY(EditAnywhere, Category = "Move")
+	bool bWithControl = false;
+
+	UPROPERTY(EditAnywhere, Category = "Move")
+	float MaxSpeed = -1.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Move")
+	float AcceptanceRadius = 1.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Move")
+	bool bUsePathfinding = false;
+};
+
+/**
+ * A behaviour described as data instead of CreateAction calls.
+ * Nodes are what designers edit or import from JSON; cooking turns them into CookedData, a flat blob of
+ * fixed-size records linked by index that is loaded in bulk with the asset and instantiated without parsing.
+ * Nodes are editor-only data, cooked games only ever see CookedData.
+ */
+UCLASS(BlueprintType)
+class NEWPROJECT_API UActionGraphAsset : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+#if WITH_EDITORONLY_DATA
+	/** Node 0 is the root, every other node is the child of exactly one composite. */
+	UPROPERTY(EditAnywhere, Category = "Graph")
+	TArray<FActionGraphNode> Nodes;
+#endif
+
+#if WITH_EDITOR
+	/** Replaces Nodes with InJson, an array of objects named after the FActionGraphNode properties, and cooks them. */
+	bool ImportFromJson(const FString& InJson, FString& OutError);
+
+	bool Validate(FString& OutError) const;
+
+	/** Validates Nodes, loads what they reference and rewrites CookedData from them. */
+	bool Cook(FString& OutError);
+#endif
+
+	bool IsCooked() const;
+	/** Whether CookedData came with the package, PostLoad had to cook the asset otherwise. */
+	FORCEINLINE bool WasLoadedCooked() const { return bLoadedCooked; }
+
+	/** Builds a new action tree from CookedData. */
+	TSharedPtr<FAction> Instantiate() const;
+
+	/** Copy of the tree built from CookedData on first use, see FActionPrototype. */
+	TSharedPtr<FAction> SpawnAction();
+
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PreSave(const class ITargetPlatform* TargetPlatform) override;
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+protected:
+	TSharedPtr<FAction> InstantiateNode(const uint8* Blob, int32 Index) const;
+
+#if WITH_EDITOR
+	/** Cooks Nodes, dropping CookedData instead of keeping a blob that no longer matches them when that fails. */
+	void Recook();
+#endif
+
+	UPROPERTY()
+	TArray<uint8> CookedData;
+
+	/** Objects and names the cooked records refer to by index. */
+	UPROPERTY()
+	TArray<UObject*> CookedObjects;
+
+	UPROPERTY()
+	TArray<FName> CookedNames;
+
+	FActionPrototype Prototype;
+
+	bool bLoadedCooked = false;
+};
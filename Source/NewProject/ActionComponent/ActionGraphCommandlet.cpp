@@ -0,0 +1,109 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "ActionGraphCommandlet.h"
+#include "ActionGraphAsset.h"
+#include "AssetRegistryModule.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+
+UActionGraphCommandlet::UActionGraphCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UActionGraphCommandlet::Main(const FString& Params)
+{
+	const bool bSave = !FParse::Param(*Params, TEXT("nosave"));
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssetsByClass(UActionGraphAsset::StaticClass()->GetFName(), Assets, true);
+
+	int32 NumFailed = 0;
+	int32 NumLoadedCooked = 0;
+	int32 NumCooked = 0;
+	int32 NumInstantiated = 0;
+	double LoadSeconds = 0.0;
+	double CookSeconds = 0.0;
+	double InstantiateSeconds = 0.0;
+	double FirstSpawnSeconds = 0.0;
+	double SpawnSeconds = 0.0;
+	for (const FAssetData& AssetData : Assets)
+	{
+		double StartTime = FPlatformTime::Seconds();
+		UActionGraphAsset* Graph = Cast<UActionGraphAsset>(AssetData.GetAsset());
+		const double GraphLoadSeconds = FPlatformTime::Seconds() - StartTime;
+		if (!Graph)
+		{
+			UE_LOG(LogActionGraph, Error, TEXT("%s could not be loaded"), *AssetData.ObjectPath.ToString());
+			++NumFailed;
+			continue;
+		}
+
+		// A graph saved without cooked data was cooked by PostLoad, its load time would mostly be cooking.
+		if (Graph->WasLoadedCooked())
+		{
+			LoadSeconds += GraphLoadSeconds;
+			++NumLoadedCooked;
+		}
+
+#if WITH_EDITOR
+		FString Error;
+		StartTime = FPlatformTime::Seconds();
+		const bool bCooked = Graph->Cook(Error);
+		CookSeconds += FPlatformTime::Seconds() - StartTime;
+		++NumCooked;
+		if (!bCooked)
+		{
+			UE_LOG(LogActionGraph, Error, TEXT("%s: %s"), *AssetData.ObjectPath.ToString(), *Error);
+			++NumFailed;
+			continue;
+		}
+#else
+		if (!Graph->IsCooked())
+		{
+			UE_LOG(LogActionGraph, Error, TEXT("%s has no cooked data"), *AssetData.ObjectPath.ToString());
+			++NumFailed;
+			continue;
+		}
+#endif
+
+		StartTime = FPlatformTime::Seconds();
+		Graph->Instantiate();
+		InstantiateSeconds += FPlatformTime::Seconds() - StartTime;
+
+		// The first spawn builds the prototype, later ones only copy it.
+		StartTime = FPlatformTime::Seconds();
+		Graph->SpawnAction();
+		FirstSpawnSeconds += FPlatformTime::Seconds() - StartTime;
+		StartTime = FPlatformTime::Seconds();
+		Graph->SpawnAction();
+		SpawnSeconds += FPlatformTime::Seconds() - StartTime;
+		++NumInstantiated;
+
+#if WITH_EDITOR
+		if (bSave)
+		{
+			UPackage* Package = Graph->GetOutermost();
+			const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+			if (!UPackage::SavePackage(Package, nullptr, RF_Standalone, *Filename, GError, nullptr, false, true, SAVE_NoError))
+			{
+				UE_LOG(LogActionGraph, Error, TEXT("%s could not be saved"), *Filename);
+				++NumFailed;
+			}
+		}
+#endif
+	}
+
+	// Milliseconds per thousand graphs, each figure over the graphs that went through that step.
+	auto PerThousand = [](double Seconds, int32 Count) { return Count > 0 ? Seconds * 1000.0 * 1000.0 / Count : 0.0; };
+	UE_LOG(LogActionGraph, Display, TEXT("%d graphs, %d failed, %d loaded with cooked data. Per thousand graphs: load %.2f ms, cook %.2f ms, instantiate %.2f ms, first spawn %.2f ms, spawn %.2f ms"),
+		Assets.Num(), NumFailed, NumLoadedCooked, PerThousand(LoadSeconds, NumLoadedCooked), PerThousand(CookSeconds, NumCooked),
+		PerThousand(InstantiateSeconds, NumInstantiated), PerThousand(FirstSpawnSeconds, NumInstantiated), PerThousand(SpawnSeconds, NumInstantiated));
+	return NumFailed > 0 ? 1 : 0;
+}
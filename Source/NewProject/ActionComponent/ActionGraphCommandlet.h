@@ -0,0 +1,24 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ActionGraphCommandlet.generated.h"
+
+/**
+ * Validates and cooks every UActionGraphAsset, then reports per thousand graphs the time to load those saved cooked,
+ * to cook, to instantiate and to spawn through the prototype.
+ * Usage: UE4Editor-Cmd NewProject -run=ActionGraph [-nosave]
+ * Returns non-zero when any graph fails to load or validate.
+ */
+UCLASS()
+class NEWPROJECT_API UActionGraphCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UActionGraphCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
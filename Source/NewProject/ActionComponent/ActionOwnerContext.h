@@ -0,0 +1,37 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ActionOwnerContext.generated.h"
+
+class APawn;
+class ACharacter;
+class UCharacterMovementComponent;
+class USkeletalMeshComponent;
+class UAnimInstance;
+
+/**
+ * Everything actions need from the pawn they run on, resolved once by UActionComponent.
+ * Rebuilt only when the possessed pawn, its mesh or its anim instance changes.
+ */
+USTRUCT()
+struct FActionOwnerContext
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY(Transient)
+	APawn* Pawn = nullptr;
+
+	UPROPERTY(Transient)
+	ACharacter* Character = nullptr;
+
+	UPROPERTY(Transient)
+	UCharacterMovementComponent* Movement = nullptr;
+
+	UPROPERTY(Transient)
+	USkeletalMeshComponent* Mesh = nullptr;
+
+	UPROPERTY(Transient)
+	UAnimInstance* AnimInstance = nullptr;
+};
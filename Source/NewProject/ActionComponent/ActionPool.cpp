@@ -0,0 +1,6 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "ActionPool.h"
+
+DEFINE_STAT(STAT_ActionAllocations);
+DEFINE_STAT(STAT_ActionRecycles);
@@ -0,0 +1,156 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ActionStats.h"
+
+/**
+ * Per-class pool behind the CreateAction factories.
+ * A released instance is reset right away, dropping its children, hooks and completion, and kept for the next acquire.
+ * The reference controller of each acquire comes from the pool as well, so a recycled action costs no allocation at all.
+ * It is still a new controller per acquire: weak pointers and SP-bound delegates taken on a previous use of the
+ * instance keep their own controller alive and no longer resolve once the instance has been released.
+ */
+template<typename ActionType>
+class TActionPool
+{
+public:
+	/** Released instances past this count are freed instead of kept, and as many controllers. */
+	static const int32 MaxPooled = 1024;
+
+	static TSharedPtr<ActionType> Acquire()
+	{
+		return Get().AcquireInstance();
+	}
+
+	/** Pooled copy of Source, detached from Source's parent, slot and owner. */
+	static TSharedPtr<ActionType> Clone(const ActionType& Source)
+	{
+		TSharedPtr<ActionType> Instance = Get().AcquireInstance();
+		*Instance = Source;
+		Instance->DetachCopy();
+		return Instance;
+	}
+
+	static int32 GetNumPooled()
+	{
+		return Get().FreeInstances.Num();
+	}
+
+private:
+	/** Releases the instance into the pool when the last shared reference goes, its own memory returns to the pool after the last weak one. */
+	class FPooledController : public SharedPointerInternals::FReferenceControllerBase
+	{
+	public:
+		explicit FPooledController(ActionType* InInstance)
+			: Instance(InInstance)
+		{}
+
+		virtual void DestroyObject() override
+		{
+			if (bShutDown)
+			{
+				delete Instance;
+				return;
+			}
+			Get().Release(Instance);
+		}
+
+		static void* operator new(size_t Size)
+		{
+			return Get().AllocateController();
+		}
+
+		static void operator delete(void* Memory)
+		{
+			if (bShutDown)
+			{
+				FMemory::Free(Memory);
+				return;
+			}
+			Get().FreeController(Memory);
+		}
+
+	private:
+		ActionType* Instance;
+	};
+
+	~TActionPool()
+	{
+		bShutDown = true;
+		for (ActionType* Instance : FreeInstances)
+		{
+			delete Instance;
+		}
+		for (void* Memory : FreeControllers)
+		{
+			FMemory::Free(Memory);
+		}
+	}
+
+	static TActionPool& Get()
+	{
+		static TActionPool Pool;
+		return Pool;
+	}
+
+	TSharedPtr<ActionType> AcquireInstance()
+	{
+		ActionType* Instance = nullptr;
+		if (FreeInstances.Num() > 0)
+		{
+			INC_DWORD_STAT(STAT_ActionRecycles);
+			Instance = FreeInstances.Pop(false);
+		}
+		else
+		{
+			INC_DWORD_STAT(STAT_ActionAllocations);
+			Instance = new ActionType();
+		}
+		FPooledController* Controller = new FPooledController(Instance);
+		return UE4SharedPointer_Private::MakeSharedRef<ActionType, ESPMode::Fast>(Instance, Controller);
+	}
+
+	void Release(ActionType* Instance)
+	{
+		// Resetting may release children into their own pools, this one included.
+		Instance->ResetAction();
+		if (FreeInstances.Num() < MaxPooled)
+		{
+			FreeInstances.Add(Instance);
+		}
+		else
+		{
+			delete Instance;
+		}
+	}
+
+	void* AllocateController()
+	{
+		if (FreeControllers.Num() > 0)
+		{
+			return FreeControllers.Pop(false);
+		}
+		INC_DWORD_STAT(STAT_ActionAllocations);
+		return FMemory::Malloc(sizeof(FPooledController), alignof(FPooledController));
+	}
+
+	void FreeController(void* Memory)
+	{
+		if (FreeControllers.Num() >= MaxPooled)
+		{
+			FMemory::Free(Memory);
+			return;
+		}
+		FreeControllers.Add(Memory);
+	}
+
+	TArray<ActionType*> FreeInstances;
+	TArray<void*> FreeControllers;
+
+	static bool bShutDown;
+};
+
+template<typename ActionType>
+bool TActionPool<ActionType>::bShutDown = false;
@@ -0,0 +1,28 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "ActionPrototype.h"
+#include "Action_Program.h"
+#include "ActionStats.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Prototype Spawns"), STAT_ActionPrototypeSpawns, STATGROUP_ActionComponent);
+
+FActionPrototype::FActionPrototype(const TSharedPtr<FAction>& InRoot, bool bCompile /*= false*/)
+{
+	if (bCompile && InRoot.IsValid())
+	{
+		Root = FAction_Program::Compile(InRoot);
+	}
+	else
+	{
+		Root = InRoot;
+	}
+}
+
+TSharedPtr<FAction> FActionPrototype::Spawn() const
+{
+	if (!Root.IsValid())
+		return nullptr;
+
+	INC_DWORD_STAT(STAT_ActionPrototypeSpawns);
+	return Root->CloneAction();
+}
@@ -0,0 +1,32 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Action.h"
+
+/**
+ * A reusable behaviour, built once from CreateAction calls and then only ever copied.
+ * The template tree is never executed, every Spawn hands out a fresh copy whose nodes and reference controllers
+ * come from the pools once its node types have been used before, only the child arrays of composites are allocated.
+ */
+class NEWPROJECT_API FActionPrototype
+{
+public:
+	FActionPrototype() {}
+
+	/** Takes over InRoot. With bCompile the template is compiled into an FAction_Program once and spawns copies of that. */
+	explicit FActionPrototype(const TSharedPtr<FAction>& InRoot, bool bCompile = false);
+
+	FORCEINLINE bool IsValid() const { return Root.IsValid(); }
+
+	TSharedPtr<FAction> Spawn() const;
+
+	template<typename ActionType>
+	TSharedPtr<ActionType> Spawn() const
+	{
+		return StaticCastSharedPtr<ActionType>(Spawn());
+	}
+
+private:
+	TSharedPtr<const FAction> Root;
+};
@@ -0,0 +1,168 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "ActionSlotArray.h"
+#include "Action.h"
+
+int32 FActionSlotArray::Add(const TSharedPtr<FAction>& InAction, EActionType InType, int32 InIndex /*= INDEX_NONE*/)
+{
+	const int32 Index = Slots.IsValidIndex(InIndex) && !Slots[InIndex].Action.IsValid() ? InIndex : FindFreeSlot();
+
+	FActionSlot& Slot = Slots[Index];
+	Slot.Action = InAction;
+	Slot.Type = InType;
+	Slot.bPendingFinish = false;
+	Slot.bReserved = false;
+	SetChannelBits(Index, InType, true);
+	++NumOccupied;
+	++Revision;
+	InAction->SlotIndex = Index;
+	return Index;
+}
+
+TSharedPtr<FAction> FActionSlotArray::RemoveAt(int32 Index)
+{
+	if (!IsOccupied(Index))
+		return nullptr;
+
+	FActionSlot& Slot = Slots[Index];
+	SetChannelBits(Index, Slot.Type, false);
+	Slot.Type = EActionType::Default;
+	Slot.bPendingFinish = false;
+	Slot.Action->SlotIndex = INDEX_NONE;
+	--NumOccupied;
+	++Revision;
+
+	return MoveTemp(Slot.Action);
+}
+
+void FActionSlotArray::SetType(int32 Index, EActionType NewType)
+{
+	if (!IsOccupied(Index))
+		return;
+
+	FActionSlot& Slot = Slots[Index];
+	if (Slot.Type == NewType)
+		return;
+	SetChannelBits(Index, Slot.Type, false);
+	Slot.Type = NewType;
+	SetChannelBits(Index, Slot.Type, true);
+}
+
+void FActionSlotArray::MarkPendingFinish(int32 Index)
+{
+	if (IsOccupied(Index))
+	{
+		Slots[Index].bPendingFinish = true;
+	}
+}
+
+int32 FActionSlotArray::Find(const FAction* InAction) const
+{
+	if (!InAction || !IsOccupied(InAction->SlotIndex) || Slots[InAction->SlotIndex].Action.Get() != InAction)
+		return INDEX_NONE;
+	return InAction->SlotIndex;
+}
+
+void FActionSlotArray::Empty()
+{
+	for (FActionSlot& Slot : Slots)
+	{
+		if (Slot.Action.IsValid())
+		{
+			Slot.Action->SlotIndex = INDEX_NONE;
+			Slot.Action.Reset();
+		}
+		Slot.Type = EActionType::Default;
+		Slot.bPendingFinish = false;
+	}
+	FMemory::Memzero(ChannelWords.GetData(), ChannelWords.Num() * sizeof(uint32));
+	FMemory::Memzero(ChannelCounts, sizeof(ChannelCounts));
+	ActiveMask = 0;
+	NumOccupied = 0;
+	++Revision;
+}
+
+int32 FActionSlotArray::Reserve()
+{
+	const int32 Index = FindFreeSlot();
+	Slots[Index].bReserved = true;
+	return Index;
+}
+
+void FActionSlotArray::CancelReservation(int32 Index)
+{
+	if (IsReserved(Index))
+	{
+		Slots[Index].bReserved = false;
+	}
+}
+
+void FActionSlotArray::GetSlotsOfType(EActionType InType, TArray<uint32, TInlineAllocator<4>>& OutWords) const
+{
+	OutWords.Reset();
+	OutWords.AddZeroed(NumWords);
+	for (uint64 Mask = (uint64)InType & ActiveMask; Mask != 0; Mask &= Mask - 1)
+	{
+		const int32 Channel = LowestActionChannel(Mask);
+		for (int32 Word = 0; Word < NumWords; ++Word)
+		{
+			OutWords[Word] |= ChannelWords[Channel * NumWords + Word];
+		}
+	}
+}
+
+int32 FActionSlotArray::FindFreeSlot()
+{
+	int32 Index = 0;
+	while (Index < Slots.Num() && (Slots[Index].Action.IsValid() || Slots[Index].bReserved))
+	{
+		++Index;
+	}
+	if (Index == Slots.Num())
+	{
+		Slots.AddDefaulted();
+		if (Slots.Num() > NumWords * 32)
+		{
+			const int32 NewNumWords = NumWords + 1;
+			TArray<uint32> NewChannelWords;
+			NewChannelWords.AddZeroed(NumChannels * NewNumWords);
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				for (int32 Word = 0; Word < NumWords; ++Word)
+				{
+					NewChannelWords[Channel * NewNumWords + Word] = ChannelWords[Channel * NumWords + Word];
+				}
+			}
+			ChannelWords = MoveTemp(NewChannelWords);
+			NumWords = NewNumWords;
+		}
+	}
+	++Slots[Index].Generation;
+	return Index;
+}
+
+void FActionSlotArray::SetChannelBits(int32 Index, EActionType InType, bool bValue)
+{
+	const int32 Word = Index / 32;
+	const uint32 Bit = 1u << (Index % 32);
+	for (uint64 Mask = (uint64)InType; Mask != 0; Mask &= Mask - 1)
+	{
+		const int32 Channel = LowestActionChannel(Mask);
+		if (bValue)
+		{
+			ChannelWords[Channel * NumWords + Word] |= Bit;
+			if (ChannelCounts[Channel]++ == 0)
+			{
+				ActiveMask |= 1ull << Channel;
+			}
+		}
+		else
+		{
+			ChannelWords[Channel * NumWords + Word] &= ~Bit;
+			if (--ChannelCounts[Channel] == 0)
+			{
+				ActiveMask &= ~(1ull << Channel);
+			}
+		}
+	}
+}
@@ -0,0 +1,138 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ActionEnums.h"
+
+class FAction;
+
+/** Names a root action of a UActionComponent, resolves to nothing once that action has left its slot. */
+struct FActionHandle
+{
+	FActionHandle()
+		: Index(INDEX_NONE)
+		, Generation(0)
+	{}
+
+	FActionHandle(int32 InIndex, uint32 InGeneration)
+		: Index(InIndex)
+		, Generation(InGeneration)
+	{}
+
+	FORCEINLINE bool IsValid() const { return Index != INDEX_NONE; }
+	FORCEINLINE void Invalidate() { Index = INDEX_NONE; Generation = 0; }
+
+	FORCEINLINE bool operator==(const FActionHandle& Other) const { return Index == Other.Index && Generation == Other.Generation; }
+	FORCEINLINE bool operator!=(const FActionHandle& Other) const { return !(*this == Other); }
+
+	int32 Index;
+	uint32 Generation;
+};
+
+struct FActionSlot
+{
+	TSharedPtr<FAction> Action;
+	EActionType Type = EActionType::Default;
+	uint32 Generation = 0;
+	bool bPendingFinish = false;
+	bool bReserved = false;
+};
+
+/**
+ * Flat storage for the root actions of a UActionComponent.
+ * Freed slots are reused and every channel keeps a bitset of the slots whose cached type contains it,
+ * so adding, removing and re-typing an action never allocates once the array has reached its working size.
+ */
+class NEWPROJECT_API FActionSlotArray
+{
+public:
+	static const int32 NumChannels = 64;
+
+	/**
+	 * Stores InAction in a free slot, or in InIndex when it is a slot returned by Reserve or just vacated by RemoveAt.
+	 * Only a fresh slot starts a new generation, so putting back an action that refused to finish keeps its handles valid.
+	 */
+	int32 Add(const TSharedPtr<FAction>& InAction, EActionType InType, int32 InIndex = INDEX_NONE);
+	TSharedPtr<FAction> RemoveAt(int32 Index);
+	void SetType(int32 Index, EActionType NewType);
+	void MarkPendingFinish(int32 Index);
+	int32 Find(const FAction* InAction) const;
+	/** Empties every occupied slot, reserved slots are kept for the commands that reserved them. */
+	void Empty();
+
+	/** Claims a free slot for an action whose execution is deferred, so a handle to it can be returned right away. */
+	int32 Reserve();
+	void CancelReservation(int32 Index);
+
+	FORCEINLINE FActionHandle GetHandle(int32 Index) const { return Slots.IsValidIndex(Index) ? FActionHandle(Index, Slots[Index].Generation) : FActionHandle(); }
+	/** Returns the slot index named by Handle, or INDEX_NONE when the handle is stale. */
+	FORCEINLINE int32 Resolve(const FActionHandle& Handle) const
+	{
+		return Slots.IsValidIndex(Handle.Index) && Slots[Handle.Index].Generation == Handle.Generation && (Slots[Handle.Index].Action.IsValid() || Slots[Handle.Index].bReserved) ? Handle.Index : INDEX_NONE;
+	}
+
+	/** Copies the per-word bitmask of the slots sharing at least one channel with InType. */
+	void GetSlotsOfType(EActionType InType, TArray<uint32, TInlineAllocator<4>>& OutWords) const;
+
+	FORCEINLINE int32 Num() const { return NumOccupied; }
+	/** Union of the channels of every occupied slot. */
+	FORCEINLINE EActionType GetActiveMask() const { return (EActionType)ActiveMask; }
+	FORCEINLINE bool ContainsType(EActionType InType) const { return (ActiveMask & (uint64)InType) != 0; }
+	FORCEINLINE int32 GetMaxIndex() const { return Slots.Num(); }
+	/** Bumped whenever an action is added or removed, lets callers cache what they derive from the root actions. */
+	FORCEINLINE uint32 GetRevision() const { return Revision; }
+	FORCEINLINE bool IsOccupied(int32 Index) const { return Slots.IsValidIndex(Index) && Slots[Index].Action.IsValid(); }
+	FORCEINLINE bool IsReserved(int32 Index) const { return Slots.IsValidIndex(Index) && Slots[Index].bReserved; }
+	FORCEINLINE const FActionSlot& operator[](int32 Index) const { return Slots[Index]; }
+
+	class FConstIterator
+	{
+	public:
+		FConstIterator(const TArray<FActionSlot>& InSlots, int32 InIndex)
+			: Slots(InSlots)
+			, Index(InIndex)
+		{
+			SkipEmpty();
+		}
+
+		FORCEINLINE FConstIterator& operator++() { ++Index; SkipEmpty(); return *this; }
+		FORCEINLINE const FActionSlot& operator*() const { return Slots[Index]; }
+		FORCEINLINE const FActionSlot* operator->() const { return &Slots[Index]; }
+		FORCEINLINE bool operator!=(const FConstIterator& Other) const { return Index != Other.Index; }
+		FORCEINLINE int32 GetIndex() const { return Index; }
+
+	private:
+		FORCEINLINE void SkipEmpty()
+		{
+			while (Index < Slots.Num() && !Slots[Index].Action.IsValid())
+			{
+				++Index;
+			}
+		}
+
+		const TArray<FActionSlot>& Slots;
+		int32 Index;
+	};
+
+	FORCEINLINE FConstIterator begin() const { return FConstIterator(Slots, 0); }
+	FORCEINLINE FConstIterator end() const { return FConstIterator(Slots, Slots.Num()); }
+
+private:
+	int32 FindFreeSlot();
+	void SetChannelBits(int32 Index, EActionType InType, bool bValue);
+
+	TArray<FActionSlot> Slots;
+
+	/** NumChannels rows of NumWords words, bit N of a row is set when slot N contains that channel. */
+	TArray<uint32> ChannelWords;
+	int32 NumWords = 0;
+
+	/** Number of occupied slots containing each channel, a channel's bit in ActiveMask is set while its count is non-zero. */
+	int32 ChannelCounts[NumChannels] = {};
+	uint64 ActiveMask = 0;
+
+	int32 NumOccupied = 0;
+
+	uint32 Revision = 0;
+};
@@ -0,0 +1,12 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("ActionComponent"), STATGROUP_ActionComponent, STATCAT_Advanced);
+
+/** Action instances and reference controllers the pools had to allocate, zero once the pools are warm. */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Action Allocations"), STAT_ActionAllocations, STATGROUP_ActionComponent, NEWPROJECT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Action Recycles"), STAT_ActionRecycles, STATGROUP_ActionComponent, NEWPROJECT_API);
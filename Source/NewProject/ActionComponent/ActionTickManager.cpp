@@ -0,0 +1,226 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "ActionTickManager.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "ActionComponent.h"
+#include "Action.h"
+#include "ActionStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("ActionTickManager"), STAT_ActionTickManager, STATGROUP_ActionComponent);
+
+static TAutoConsoleVariable<int32> CVarActionBatchedTick(
+	TEXT("ActionComponent.BatchedTick"),
+	0,
+	TEXT("When non-zero, action components registered afterwards are ticked by one world-level tick function instead of their own."),
+	ECVF_Default);
+
+TMap<TWeakObjectPtr<UWorld>, UActionTickManager*> UActionTickManager::Managers;
+
+void FActionTickManagerTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Target && TickType != LEVELTICK_ViewportsOnly)
+	{
+		Target->Tick(DeltaTime);
+	}
+}
+
+FString FActionTickManagerTickFunction::DiagnosticMessage()
+{
+	return TEXT("ActionTickManager");
+}
+
+bool UActionTickManager::IsBatchedTickEnabled()
+{
+	return CVarActionBatchedTick.GetValueOnGameThread() != 0;
+}
+
+UActionTickManager* UActionTickManager::Get(UWorld* World, bool bCreateIfMissing /*= true*/)
+{
+	if (!World)
+		return nullptr;
+
+	if (UActionTickManager** Found = Managers.Find(World))
+	{
+		return *Found;
+	}
+	if (!bCreateIfMissing)
+		return nullptr;
+
+	static bool bBoundWorldCleanup = false;
+	if (!bBoundWorldCleanup)
+	{
+		bBoundWorldCleanup = true;
+		FWorldDelegates::OnWorldCleanup.AddStatic(&UActionTickManager::OnWorldCleanup);
+	}
+
+	UActionTickManager* Manager = NewObject<UActionTickManager>(World);
+	Manager->AddToRoot();
+	Manager->Initialize(World);
+	Managers.Add(World, Manager);
+	return Manager;
+}
+
+void UActionTickManager::Initialize(UWorld* InWorld)
+{
+	TickFunction.bCanEverTick = true;
+	TickFunction.bStartWithTickEnabled = true;
+	TickFunction.TickGroup = TG_PrePhysics;
+	TickFunction.Target = this;
+	TickFunction.RegisterTickFunction(InWorld->PersistentLevel);
+}
+
+void UActionTickManager::Shutdown()
+{
+	if (TickFunction.IsTickFunctionRegistered())
+	{
+		TickFunction.UnRegisterTickFunction();
+	}
+	TickFunction.Target = nullptr;
+	for (UActionComponent* Component : Components)
+	{
+		if (Component)
+		{
+			Component->TickManager = nullptr;
+			Component->TickEntryRefs.Reset();
+		}
+	}
+	Components.Reset();
+	Buckets.Reset();
+	BucketIndices.Reset();
+	DeferredSlots.Reset();
+	RemoveFromRoot();
+}
+
+void UActionTickManager::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	UActionTickManager* Manager = nullptr;
+	if (Managers.RemoveAndCopyValue(World, Manager) && Manager)
+	{
+		Manager->Shutdown();
+	}
+}
+
+void UActionTickManager::RegisterComponent(UActionComponent* InComponent)
+{
+	if (!InComponent || InComponent->TickManager == this)
+		return;
+
+	Components.Add(InComponent);
+	InComponent->TickManager = this;
+	const FActionSlotArray& Actions = InComponent->GetAllActions();
+	for (auto It = Actions.begin(); It != Actions.end(); ++It)
+	{
+		UpdateSlot(InComponent, It.GetIndex());
+	}
+}
+
+void UActionTickManager::UnregisterComponent(UActionComponent* InComponent)
+{
+	if (!InComponent || InComponent->TickManager != this)
+		return;
+
+	Components.RemoveSwap(InComponent);
+	InComponent->TickManager = nullptr;
+	for (int32 SlotIndex = 0; SlotIndex < InComponent->TickEntryRefs.Num(); ++SlotIndex)
+	{
+		UpdateSlot(InComponent, SlotIndex);
+	}
+}
+
+void UActionTickManager::UpdateSlot(UActionComponent* InComponent, int32 SlotIndex)
+{
+	if (bTickingBuckets)
+	{
+		DeferredSlots.Emplace(InComponent, SlotIndex);
+		return;
+	}
+
+	TArray<FActionTickEntryRef>& Refs = InComponent->TickEntryRefs;
+	if (SlotIndex >= Refs.Num())
+	{
+		Refs.SetNum(SlotIndex + 1);
+	}
+
+	const FActionSlotArray& Actions = InComponent->GetAllActions();
+	FAction* Action = InComponent->TickManager == this && Actions.IsOccupied(SlotIndex) ? Actions[SlotIndex].Action.Get() : nullptr;
+	if (Refs[SlotIndex].Bucket != INDEX_NONE)
+	{
+		const FActionTickEntryRef Ref = Refs[SlotIndex];
+		if (Action && Buckets[Ref.Bucket].ClassId == Action->GetClassId())
+		{
+			Buckets[Ref.Bucket].Entries[Ref.Entry].Action = Action;
+			return;
+		}
+		RemoveEntry(Ref);
+		Refs[SlotIndex] = FActionTickEntryRef();
+	}
+	if (!Action)
+		return;
+
+	const FActionClassId ClassId = Action->GetClassId();
+	int32* BucketIndex = BucketIndices.Find(ClassId);
+	if (!BucketIndex)
+	{
+		BucketIndex = &BucketIndices.Add(ClassId, Buckets.AddDefaulted());
+		Buckets[*BucketIndex].ClassId = ClassId;
+	}
+	FActionTickEntryRef& Ref = Refs[SlotIndex];
+	Ref.Bucket = *BucketIndex;
+	Ref.Entry = Buckets[*BucketIndex].Entries.Add({ InComponent, Action, SlotIndex });
+}
+
+void UActionTickManager::RemoveEntry(FActionTickEntryRef Ref)
+{
+	TArray<FActionTickEntry>& Entries = Buckets[Ref.Bucket].Entries;
+	Entries.RemoveAtSwap(Ref.Entry, 1, false);
+	if (Entries.IsValidIndex(Ref.Entry))
+	{
+		const FActionTickEntry& Moved = Entries[Ref.Entry];
+		Moved.Component->TickEntryRefs[Moved.SlotIndex].Entry = Ref.Entry;
+	}
+}
+
+void UActionTickManager::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ActionTickManager);
+
+	TickedComponents.Reset();
+	for (UActionComponent* Component : Components)
+	{
+		if (!Component || Component->IsPendingKill() || !Component->IsActive() || Component->bActionTickSleeping)
+			continue;
+
+		Component->BeginTickActions();
+		TickedComponents.Add(Component);
+	}
+
+	// Components being ticked defer their slot changes to EndTickActions, any other component's are deferred here.
+	bTickingBuckets = true;
+	for (const FActionTickBucket& Bucket : Buckets)
+	{
+		for (const FActionTickEntry& Entry : Bucket.Entries)
+		{
+			if (!Entry.Component->bIsTickingActions)
+				continue;
+
+			const AActor* Owner = Entry.Component->GetOwner();
+			const float ComponentDeltaTime = Owner ? DeltaTime * Owner->CustomTimeDilation : DeltaTime;
+			Entry.Component->TickActionSlot(Entry.SlotIndex, Entry.Action, ComponentDeltaTime);
+		}
+	}
+	bTickingBuckets = false;
+
+	for (int32 Index = 0; Index < DeferredSlots.Num(); ++Index)
+	{
+		UpdateSlot(DeferredSlots[Index].Key, DeferredSlots[Index].Value);
+	}
+	DeferredSlots.Reset();
+
+	for (UActionComponent* Component : TickedComponents)
+	{
+		Component->EndTickActions();
+	}
+}
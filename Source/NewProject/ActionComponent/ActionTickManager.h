@@ -0,0 +1,104 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Action.h"
+#include "ActionTickManager.generated.h"
+
+class UActionComponent;
+class UActionTickManager;
+class UWorld;
+
+USTRUCT()
+struct FActionTickManagerTickFunction : public FTickFunction
+{
+	GENERATED_USTRUCT_BODY()
+
+	UActionTickManager* Target = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FActionTickManagerTickFunction> : public TStructOpsTypeTraitsBase2<FActionTickManagerTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+struct FActionTickEntry
+{
+	UActionComponent* Component;
+	FAction* Action;
+	int32 SlotIndex;
+};
+
+/** Root actions of one class, ticked one after the other so consecutive ticks run the same code. */
+struct FActionTickBucket
+{
+	FActionClassId ClassId;
+	TArray<FActionTickEntry> Entries;
+};
+
+/** Position of a slot's entry in the buckets of UActionTickManager. */
+struct FActionTickEntryRef
+{
+	int32 Bucket = INDEX_NONE;
+	int32 Entry = INDEX_NONE;
+};
+
+/**
+ * Ticks the actions of every registered UActionComponent of a world from one tick function.
+ * Opt-in through ActionComponent.BatchedTick; components registered here never register their own tick function.
+ * Root actions are filed into per-class buckets as they enter and leave their slots, so a tick only walks the buckets.
+ * A static world map rather than a UWorldSubsystem, which this engine version does not have yet.
+ */
+UCLASS(Transient)
+class NEWPROJECT_API UActionTickManager : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	static bool IsBatchedTickEnabled();
+
+	static UActionTickManager* Get(UWorld* World, bool bCreateIfMissing = true);
+
+	void RegisterComponent(UActionComponent* InComponent);
+	void UnregisterComponent(UActionComponent* InComponent);
+	/** Files the action now in slot SlotIndex of InComponent, or drops the slot's entry when it left. Deferred while the buckets are ticked. */
+	void UpdateSlot(UActionComponent* InComponent, int32 SlotIndex);
+
+	void Tick(float DeltaTime);
+
+	FORCEINLINE int32 GetNumComponents() const { return Components.Num(); }
+
+protected:
+	void Initialize(UWorld* InWorld);
+	void Shutdown();
+
+	static void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+
+	FActionTickManagerTickFunction TickFunction;
+
+	UPROPERTY(Transient)
+	TArray<UActionComponent*> Components;
+
+	void RemoveEntry(FActionTickEntryRef Ref);
+
+	TArray<UActionComponent*> TickedComponents;
+	TArray<FActionTickBucket> Buckets;
+	/** Only looked up when an action enters a slot. */
+	TMap<FActionClassId, int32> BucketIndices;
+
+	/** Slots changed by components outside the tick while the buckets were walked. */
+	TArray<TPair<UActionComponent*, int32>> DeferredSlots;
+	bool bTickingBuckets = false;
+
+	static TMap<TWeakObjectPtr<UWorld>, UActionTickManager*> Managers;
+};
@@ -1,6 +1,7 @@
 // Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
 
 #include "Action_AnimRootMotionMoveToLocation.h"
+#include "ActionPool.h"
 #include "Animation/AnimMontage.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/Character.h"
@@ -19,7 +20,7 @@ TSharedPtr<FAction_AnimRootMotionMoveToLocation> FAction_AnimRootMotionMoveToLoc
 		return nullptr;
 	}
 
-	TSharedPtr<FAction_AnimRootMotionMoveToLocation> Action = MakeShareable(new FAction_AnimRootMotionMoveToLocation());
+	TSharedPtr<FAction_AnimRootMotionMoveToLocation> Action = TActionPool<FAction_AnimRootMotionMoveToLocation>::Acquire();
 	if (Action.IsValid())
 	{
 		Action->AnimMontage = InAnimMontage;
@@ -40,6 +41,22 @@ TSharedPtr<FAction_AnimRootMotionMoveToLocation> FAction_AnimRootMotionMoveToLoc
 	return Action;
 }
 
+void FAction_AnimRootMotionMoveToLocation::ResetAction()
+{
+	*this = FAction_AnimRootMotionMoveToLocation();
+}
+
+TSharedPtr<FAction> FAction_AnimRootMotionMoveToLocation::CloneAction() const
+{
+	return TActionPool<FAction_AnimRootMotionMoveToLocation>::Clone(*this);
+}
+
+void FAction_AnimRootMotionMoveToLocation::RearmAction()
+{
+	FAction_PlayRootMotion::RearmAction();
+	bRootMotionFinished = false;
+}
+
 EActionResult FAction_AnimRootMotionMoveToLocation::ExecuteAction()
 {
 	EActionResult Result = FAction_PlayRootMotion::ExecuteAction();
@@ -47,7 +64,7 @@ EActionResult FAction_AnimRootMotionMoveToLocation::ExecuteAction()
 	{
 		return Result;
 	}
-	ACharacter *Character = Cast<ACharacter>(GetOwner());
+	ACharacter *Character = GetOwnerContext().Character;
 	MovementCompPtr = nullptr;
 	if (Character)
 	{
@@ -83,7 +100,7 @@ EActionResult FAction_AnimRootMotionMoveToLocation::ExecuteAction()
 	return Result;
 }
 
-bool FAction_AnimRootMotionMoveToLocation::FinishAction(EActionResult InResult, const FString& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
+bool FAction_AnimRootMotionMoveToLocation::FinishAction(EActionResult InResult, const FActionFinishReason& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
 {
 	if (MovementCompPtr.IsValid())
 	{
@@ -100,13 +117,13 @@ bool FAction_AnimRootMotionMoveToLocation::FinishAction(EActionResult InResult,
 			MovementCompPtr->Velocity = FinishSetVelocity;
 		}
 	}
-	return FAction_PlayRootMotion::FinishAction(InResult, TEXT(""), StopType);
+	return FAction_PlayRootMotion::FinishAction(InResult, Reason, StopType);
 }
 
 EActionResult FAction_AnimRootMotionMoveToLocation::TickAction(float DeltaTime)
 {
 	CurrentTime += DeltaTime;
-	ACharacter *Character = Cast<ACharacter>(GetOwner());
+	ACharacter *Character = GetOwnerContext().Character;
 	if (Character)
 	{
 		FTransform CurrentTransform = AnimMontage->ExtractRootMotionFromTrackRange(0.0f, CurrentTime);
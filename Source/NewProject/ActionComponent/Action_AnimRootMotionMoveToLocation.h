@@ -15,13 +15,19 @@ DECLARE_DELEGATE_RetVal_OneParam(FVector, FOnChangeAnimRootMotionLocation, const
 class NEWPROJECT_API FAction_AnimRootMotionMoveToLocation : public FAction_PlayRootMotion
 {
 public:
+	DECLARE_ACTION_CLASS()
+
 	FAction_AnimRootMotionMoveToLocation() { Type = EActionType::Animation | EActionType::Move | EActionType::Rotate; }
 
 	static TSharedPtr<FAction_AnimRootMotionMoveToLocation> CreateAction(UAnimMontage* InAnimMontage, FTransform TargetTransform = FTransform(FRotator(FLT_MAX, FLT_MAX, FLT_MAX), FVector(FLT_MAX, FLT_MAX, FLT_MAX)), float Duration = -1.0f, float InMoveDurationRatio = 0.05f, bool bSetNewMovementMode = true, EMovementMode MovementMode = MOVE_Flying, UCurveVector* PathOffsetCurve = nullptr, ERootMotionFinishVelocityMode VelocityOnFinishMode = ERootMotionFinishVelocityMode::MaintainLastRootMotionVelocity, FVector SetVelocityOnFinish = FVector::ZeroVector, float ClampVelocityOnFinish = 0.0f, float InPlayRate = -1.0f);
+	virtual void ResetAction() override;
+	virtual TSharedPtr<FAction> CloneAction() const override;
+	virtual void RearmAction() override;
 
 	virtual EActionResult ExecuteAction() override;
-	virtual bool FinishAction(EActionResult InResult, const FString& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
+	virtual bool FinishAction(EActionResult InResult, const FActionFinishReason& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
 	virtual EActionResult TickAction(float DeltaTime) override;
+	virtual bool NeedsTick() const override { return true; }
 
 	FOnChangeAnimRootMotionLocation OnChangeAnimRootMotionLocation;
 
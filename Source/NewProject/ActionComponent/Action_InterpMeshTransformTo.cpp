@@ -1,6 +1,7 @@
 // Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
 
 #include "Action_InterpMeshTransformTo.h"
+#include "ActionPool.h"
 #include "GameFramework/Character.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Components/SkeletalMeshComponent.h"
@@ -9,7 +10,7 @@
 
 TSharedPtr<FAction_InterpMeshTransformTo> FAction_InterpMeshTransformTo::CreateAction(const FTransform& InTransform, float InDuration)
 {
-	TSharedPtr<FAction_InterpMeshTransformTo> Action = MakeShareable(new FAction_InterpMeshTransformTo());
+	TSharedPtr<FAction_InterpMeshTransformTo> Action = TActionPool<FAction_InterpMeshTransformTo>::Acquire();
 	if (Action.IsValid())
 	{
 		Action->TargetTransform = InTransform;
@@ -18,9 +19,19 @@ TSharedPtr<FAction_InterpMeshTransformTo> FAction_InterpMeshTransformTo::CreateA
 	return Action;
 }
 
+void FAction_InterpMeshTransformTo::ResetAction()
+{
+	*this = FAction_InterpMeshTransformTo();
+}
+
+TSharedPtr<FAction> FAction_InterpMeshTransformTo::CloneAction() const
+{
+	return TActionPool<FAction_InterpMeshTransformTo>::Clone(*this);
+}
+
 EActionResult FAction_InterpMeshTransformTo::ExecuteAction()
 {
-	APawn* PawnOwner = Cast<APawn>(GetOwner());
+	APawn* PawnOwner = GetOwnerContext().Pawn;
 	if (!PawnOwner)
 	{
 		return EActionResult::Fail;
@@ -32,7 +43,7 @@ EActionResult FAction_InterpMeshTransformTo::ExecuteAction()
 
 	OriginalMeshTransformOffset = PawnOwner->GetActorTransform();
 
-	ACharacter* Character = Cast<ACharacter>(GetOwner());
+	ACharacter* Character = GetOwnerContext().Character;
 	if (Character)
 	{
 		auto ClientData = Character->GetCharacterMovement()->GetPredictionData_Client_Character();
@@ -78,7 +89,7 @@ EActionResult FAction_InterpMeshTransformTo::ExecuteAction()
 
 EActionResult FAction_InterpMeshTransformTo::TickAction(float DeltaTime)
 {
-	ACharacter* PawnOwner = Cast<ACharacter>(GetOwner());
+	ACharacter* PawnOwner = GetOwnerContext().Character;
 	if (!PawnOwner)
 	{
 		return EActionResult::Fail;
@@ -11,9 +11,13 @@ class NEWPROJECT_API FAction_InterpMeshTransformTo : public FAction
 {
 
 public:
+	DECLARE_ACTION_CLASS()
+
 	FAction_InterpMeshTransformTo() { Type = EActionType::MeshMove | EActionType::MeshRotate | EActionType::MeshScale; }
 
 	static TSharedPtr<FAction_InterpMeshTransformTo> CreateAction(const FTransform& InTransform, float InDuration);
+	virtual void ResetAction() override;
+	virtual TSharedPtr<FAction> CloneAction() const override;
 
 protected:
 
@@ -1,6 +1,7 @@
 // Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
 
 #include "Action_InterpMoveTo.h"
+#include "ActionPool.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/Character.h"
 #include "GameFramework/PlayerController.h"
@@ -11,7 +12,7 @@ DECLARE_CYCLE_STAT(TEXT("MoveTo"), STAT_InterpMoveTo, STATGROUP_AI);
 
 TSharedPtr<FAction_InterpMoveTo> FAction_InterpMoveTo::CreateAction(const FVector& InDestLocation, float InDuration /*= 0.001f*/, UCurveBase* InCurve /*= nullptr*/, bool InbWithOutControl /*= false*/)
 {
-	TSharedPtr<FAction_InterpMoveTo> Action = MakeShareable(new FAction_InterpMoveTo());
+	TSharedPtr<FAction_InterpMoveTo> Action = TActionPool<FAction_InterpMoveTo>::Acquire();
 	if (Action.IsValid())
 	{
 		Action->DestLocation = InDestLocation;
@@ -38,7 +39,7 @@ TSharedPtr<FAction_InterpMoveTo> FAction_InterpMoveTo::CreateAction(const FVecto
 
 TSharedPtr<FAction_InterpMoveTo> FAction_InterpMoveTo::CreateAction(const AActor* InGoal, float InDuration /*= 0.001f*/, UCurveBase* InCurve /*= nullptr*/, bool InbWithOutControl /*= false*/)
 {
-	TSharedPtr<FAction_InterpMoveTo> Action = MakeShareable(new FAction_InterpMoveTo());
+	TSharedPtr<FAction_InterpMoveTo> Action = TActionPool<FAction_InterpMoveTo>::Acquire();
 	if (Action.IsValid())
 	{
 		Action->Duration = InDuration;
@@ -64,9 +65,19 @@ TSharedPtr<FAction_InterpMoveTo> FAction_InterpMoveTo::CreateAction(const AActor
 
 }
 
+void FAction_InterpMoveTo::ResetAction()
+{
+	*this = FAction_InterpMoveTo();
+}
+
+TSharedPtr<FAction> FAction_InterpMoveTo::CloneAction() const
+{
+	return TActionPool<FAction_InterpMoveTo>::Clone(*this);
+}
+
 EActionResult FAction_InterpMoveTo::ExecuteAction()
 {
-	Character = Cast<ACharacter>(GetOwner());
+	Character = GetOwnerContext().Character;
 	MovementComp = Character.IsValid() ? Character->GetCharacterMovement() : nullptr;
 	if (!MovementComp.IsValid())
 	{
@@ -104,7 +115,7 @@ EActionResult FAction_InterpMoveTo::ExecuteAction()
 	return EActionResult::Wait;
 }
 
-bool FAction_InterpMoveTo::FinishAction(EActionResult InResult, const FString& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
+bool FAction_InterpMoveTo::FinishAction(EActionResult InResult, const FActionFinishReason& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
 {
 	APlayerController* PlayerController = Cast<APlayerController>(Character->GetController());
 	if (PlayerController)
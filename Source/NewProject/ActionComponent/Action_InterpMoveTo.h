@@ -13,11 +13,15 @@ class ACharacter;
 class NEWPROJECT_API FAction_InterpMoveTo : public FAction_MoveTo
 {
 public:
+	DECLARE_ACTION_CLASS()
+
 	static TSharedPtr<FAction_InterpMoveTo> CreateAction(const FVector& InDestLocation, float InDuration = 0.001f, UCurveBase* InCurve = nullptr, bool InbWithControl = false);
 	static TSharedPtr<FAction_InterpMoveTo> CreateAction(const AActor* InGoal, float InDuration = 0.001f, UCurveBase* InCurve = nullptr, bool InbWithOutControl = false);
+	virtual void ResetAction() override;
+	virtual TSharedPtr<FAction> CloneAction() const override;
 
 	virtual EActionResult ExecuteAction() override;
-	virtual bool FinishAction(EActionResult InResult, const FString& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
+	virtual bool FinishAction(EActionResult InResult, const FActionFinishReason& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
 	virtual EActionResult TickAction(float DeltaTime) override;
 
 	uint32 bOrientRotationToMovement : 1;
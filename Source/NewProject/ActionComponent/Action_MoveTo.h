@@ -11,6 +11,8 @@ class NEWPROJECT_API FAction_MoveTo : public FAction
 {
 
 public:
+	DECLARE_ACTION_CLASS()
+
 	FAction_MoveTo() { Type = EActionType::Move; }
 
 protected:
@@ -1,29 +1,159 @@
 // Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
 
 #include "Action_Parallel.h"
+#include "ActionPool.h"
 
 TSharedPtr<FAction_Parallel> FAction_Parallel::CreateAction(TSharedPtr<FAction> InMajor, TSharedPtr<FAction> InMinor)
 {
-	TSharedPtr<FAction_Parallel> Action = MakeShareable(new FAction_Parallel());
+	if (!InMajor.IsValid())
+		return nullptr;
+
+	TSharedPtr<FAction_Parallel> Action = TActionPool<FAction_Parallel>::Acquire();
 	if (Action.IsValid())
 	{
-		Action->PendingMajor = InMajor;
-		Action->PendingMinor = InMinor;
-		Action->PendingMajor->ParentAction = Action;
-		Action->PendingMinor->ParentAction = Action;
+		Action->JoinPolicy = EActionJoinPolicy::Major;
+		Action->AddChild(InMajor);
+		Action->AddChild(InMinor);
 		Action->NotifyTypeChanged();
 	}
 	return Action;
 }
 
-TArray<const FAction*> FAction_Parallel::GetActiveActions() const
+TSharedPtr<FAction_Parallel> FAction_Parallel::CreateAction(const std::initializer_list<TSharedPtr<FAction>>& InActions, EActionJoinPolicy InJoinPolicy /*= EActionJoinPolicy::All*/, int32 InRequiredCount /*= 1*/)
+{
+	return CreateFromRange(InActions, InJoinPolicy, InRequiredCount);
+}
+
+TSharedPtr<FAction_Parallel> FAction_Parallel::CreateAction(const TArray<TSharedPtr<FAction>>& InActions, EActionJoinPolicy InJoinPolicy /*= EActionJoinPolicy::All*/, int32 InRequiredCount /*= 1*/)
+{
+	return CreateFromRange(InActions, InJoinPolicy, InRequiredCount);
+}
+
+template<typename RangeType>
+TSharedPtr<FAction_Parallel> FAction_Parallel::CreateFromRange(const RangeType& InActions, EActionJoinPolicy InJoinPolicy, int32 InRequiredCount)
+{
+	TSharedPtr<FAction_Parallel> Action = TActionPool<FAction_Parallel>::Acquire();
+	if (Action.IsValid())
+	{
+		Action->JoinPolicy = InJoinPolicy;
+		Action->RequiredCount = InRequiredCount;
+		for (const TSharedPtr<FAction>& SingleAction : InActions)
+		{
+			Action->AddChild(SingleAction);
+		}
+		Action->NotifyTypeChanged();
+	}
+	return Action;
+}
+
+void FAction_Parallel::ResetAction()
+{
+	*this = FAction_Parallel();
+}
+
+TSharedPtr<FAction> FAction_Parallel::CloneAction() const
+{
+	TSharedPtr<FAction_Parallel> Action = TActionPool<FAction_Parallel>::Acquire();
+	if (Action.IsValid())
+	{
+		CopyTo(*Action);
+	}
+	return Action;
+}
+
+void FAction_Parallel::CopyTo(FAction_Parallel& Action) const
+{
+	static_cast<FAction&>(Action) = *this;
+	Action.DetachCopy();
+	Action.bStopSeparateType = bStopSeparateType;
+	Action.JoinPolicy = JoinPolicy;
+	Action.RequiredCount = RequiredCount;
+	Action.NumRunning = NumRunning;
+	Action.NumSucceeded = NumSucceeded;
+	Action.NumUnstarted = NumUnstarted;
+	Action.bStarted = bStarted;
+	Action.bJoined = bJoined;
+	for (const FParallelChild& Child : Children)
+	{
+		TSharedPtr<FAction> ChildClone = Child.Action->CloneAction();
+		ChildClone->ParentAction = Action.AsShared();
+		ChildClone->IndexInParent = Action.Children.Num();
+		FParallelChild& NewChild = Action.Children[Action.Children.AddDefaulted()];
+		NewChild.Action = ChildClone;
+		NewChild.bRunning = Child.bRunning;
+	}
+}
+
+void FAction_Parallel::RearmAction()
+{
+	for (FParallelChild& Child : Children)
+	{
+		Child.Action->RearmAction();
+		Child.bRunning = false;
+	}
+	NumRunning = 0;
+	NumSucceeded = 0;
+	NumUnstarted = 0;
+	bStarted = false;
+	bJoined = false;
+	UpdateType();
+}
+
+void FAction_Parallel::RetainFinishedChildren()
+{
+	for (const FParallelChild& Child : Children)
+	{
+		Child.Action->RetainFinishedChildren();
+	}
+}
+
+void FAction_Parallel::AddChild(const TSharedPtr<FAction>& InAction)
+{
+	if (!InAction.IsValid())
+		return;
+
+	if ((JoinPolicy == EActionJoinPolicy::All || JoinPolicy == EActionJoinPolicy::Any) && InAction->GetClassId() == GetClassId())
+	{
+		const FAction_Parallel* Nested = static_cast<const FAction_Parallel*>(InAction.Get());
+		// Only a plain nested group is flattened, anything observing or configuring it would be lost with it.
+		// Its children are copied so whoever still holds the nested group keeps an intact one.
+		if (Nested->JoinPolicy == JoinPolicy && Nested->bStopSeparateType == bStopSeparateType && !Nested->bStarted && Nested->IsPlain())
+		{
+			for (const FParallelChild& Child : Nested->Children)
+			{
+				AddChild(Child.Action->CloneAction());
+			}
+			return;
+		}
+	}
+
+	InAction->ParentAction = AsShared();
+	InAction->IndexInParent = Children.Num();
+	Children[Children.AddDefaulted()].Action = InAction;
+}
+
+bool FAction_Parallel::ForEachActiveAction(TFunctionRef<bool(const FAction*)> Visitor) const
+{
+	for (const FParallelChild& Child : Children)
+	{
+		if (Child.bRunning && !Child.Action->ForEachActiveAction(Visitor))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FAction_Parallel::NeedsTick() const
 {
-	TArray<const FAction*> Ret;
-	if (Major.IsValid())
-		Ret.Append(Major->GetActiveActions());
-	if (Minor.IsValid())
-		Ret.Append(Minor->GetActiveActions());
-	return Ret;
+	for (const FParallelChild& Child : Children)
+	{
+		if (Child.bRunning && Child.Action->NeedsTick())
+		{
+			return true;
+		}
+	}
+	return false;
 }
 
 FName FAction_Parallel::GetName() const
@@ -33,83 +163,94 @@ FName FAction_Parallel::GetName() const
 
 FString FAction_Parallel::GetDescription() const
 {
-	FAction *MajorPtr = Major.Get();
-	if (MajorPtr == nullptr)
-	{
-		MajorPtr = PendingMajor.Get();
-	}
-	FAction *MinorPtr = Minor.Get();
-	if (MinorPtr == nullptr)
+	FString ParallelString;
+	for (const FParallelChild& Child : Children)
 	{
-		MinorPtr = PendingMinor.Get();
+		ParallelString += TEXT("[") + Child.Action->GetDescription() + TEXT("], ");
 	}
-	FString ParallelString = TEXT("MajorPtr : [") + (MajorPtr ? MajorPtr->GetDescription() : FString()) + TEXT("], MinorPtr : [") + (MinorPtr ? MinorPtr->GetDescription() : FString()) + TEXT("]");
+	ParallelString.RemoveFromEnd(TEXT(", "));
 	return FString::Printf(TEXT("%s (Parallel:{%s}"), *GetName().ToString(), *ParallelString);
 }
 
 EActionResult FAction_Parallel::ExecuteAction()
 {
-	if (!PendingMajor.IsValid())
+	if (Children.Num() == 0)
 		return EActionResult::Fail;
-	PendingMajor->SetActionComponent(GetActionComponent());
-	PendingMajor->SetOwner(GetOwner());
-	EActionResult MajorResult = PendingMajor->DoExecuteAction();
-	if (MajorResult == EActionResult::Wait)
-	{
-		Major = PendingMajor;
-	}
-	PendingMajor.Reset();
-	NotifyTypeChanged();
 
-	PendingMinor->SetActionComponent(GetActionComponent());
-	PendingMinor->SetOwner(GetOwner());
-	EActionResult MinorResult = PendingMinor->DoExecuteAction();
-	if (MinorResult == EActionResult::Wait)
+	bStarted = true;
+	bJoined = false;
+	NumRunning = 0;
+	NumSucceeded = 0;
+	NumUnstarted = Children.Num();
+	for (int32 Index = 0; Index < Children.Num(); ++Index)
 	{
-		Minor = PendingMinor;
+		FAction* Action = Children[Index].Action.Get();
+		--NumUnstarted;
+		Action->SetActionComponent(GetActionComponent());
+		Action->SetOwner(GetOwner());
+		EActionResult Result = Action->DoExecuteAction();
+		if (Result == EActionResult::Wait)
+		{
+			Children[Index].bRunning = true;
+			++NumRunning;
+			continue;
+		}
+
+		Result = JoinChild(Index, Result);
+		if (Result != EActionResult::Wait)
+		{
+			NumUnstarted = 0;
+			FinishAction(EActionResult::Abort);
+			return Result;
+		}
 	}
-	PendingMinor.Reset();
 	NotifyTypeChanged();
-
-	return MajorResult;
+	return EActionResult::Wait;
 }
 
-bool FAction_Parallel::FinishAction(EActionResult InResult, const FString& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
+bool FAction_Parallel::FinishAction(EActionResult InResult, const FActionFinishReason& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
 {
-	if (Major.IsValid())
+	const bool bStopByType = bStopSeparateType && StopType != EActionType::Default;
+	for (int32 Index = 0; Index < Children.Num(); ++Index)
 	{
-		TSharedPtr<FAction> Action = Major;
-		Major.Reset();
-		if (Action->DoFinishAction(InResult, Reason, StopType) == false)
+		FParallelChild& Child = Children[Index];
+		const bool bMajorStopped = JoinPolicy == EActionJoinPolicy::Major && !Children[0].bRunning;
+		if (!Child.bRunning || (bStopByType && !bMajorStopped && !Child.Action->IsType(StopType)))
+			continue;
+
+		const bool bIsMajor = JoinPolicy == EActionJoinPolicy::Major && Index == 0;
+		Child.bRunning = false;
+		--NumRunning;
+		// A child still running here was interrupted, it did not produce the group's result. Clean passes through so
+		// teardown stays silent as it does for sequences.
+		if (Child.Action->DoFinishAction(InResult == EActionResult::Clean ? EActionResult::Clean : EActionResult::Abort, Reason, StopType) == false)
 		{
-			Major = Action;
-			NotifyTypeChanged();
-			return false;
+			Child.bRunning = true;
+			++NumRunning;
+			if (bIsMajor)
+				break;
 		}
 	}
-	if (Minor.IsValid())
+
+	if (NumRunning > 0)
 	{
-		TSharedPtr<FAction> Action = Minor;
-		Minor.Reset();
-		Action->DoFinishAction(EActionResult::Abort, Reason, StopType);
+		NotifyTypeChanged();
+		return false;
 	}
 	return true;
 }
 
 EActionResult FAction_Parallel::TickAction(float DeltaTime)
 {
-	EActionResult Result = Major->DoTickAction(DeltaTime);
-	if (Result != EActionResult::Wait)
+	for (int32 Index = 0; Index < Children.Num() && !bJoined; ++Index)
 	{
-		FinishChildAction(Major.Get(), Result);
-		return Result;
-	}
-	if (Minor.IsValid())
-	{
-		Result = Minor->DoTickAction(DeltaTime);
+		if (!Children[Index].bRunning)
+			continue;
+		FAction* Action = Children[Index].Action.Get();
+		EActionResult Result = Action->DoTickAction(DeltaTime);
 		if (Result != EActionResult::Wait)
 		{
-			FinishChildAction(Minor.Get(), Result);
+			FinishChildAction(Action, Result);
 		}
 	}
 	return EActionResult::Wait;
@@ -118,67 +259,80 @@ EActionResult FAction_Parallel::TickAction(float DeltaTime)
 void FAction_Parallel::UpdateType()
 {
 	Type = EActionType::Default;
-	if (Major.IsValid())
+	for (const FParallelChild& Child : Children)
 	{
-		Type = Major->GetType();
+		if (Child.bRunning || !bStarted)
+		{
+			Type |= Child.Action->GetType();
+		}
 	}
-	if (Minor.IsValid() && Major.IsValid())
+}
+
+bool FAction_Parallel::FinishChildAction(FAction* InAction, EActionResult InResult, const FActionFinishReason& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
+{
+	if (!InAction || !Children.IsValidIndex(InAction->IndexInParent))
+		return true;
+
+	const int32 Index = InAction->IndexInParent;
+	if (!Children[Index].bRunning || Children[Index].Action.Get() != InAction)
+		return true;
+
+	Children[Index].bRunning = false;
+	--NumRunning;
+	if (InAction->DoFinishAction(InResult, Reason, StopType) == false)
 	{
-		Type = Major->GetType() | Minor->GetType();
+		Children[Index].bRunning = true;
+		++NumRunning;
+		NotifyTypeChanged();
+		return false;
 	}
-	if (PendingMajor.IsValid())
+
+	const EActionResult Result = JoinChild(Index, InResult);
+	if (Result != EActionResult::Wait)
 	{
-		Type = PendingMajor->GetType();
+		bJoined = true;
+		NotifyActionFinish(Result, Reason);
 	}
-	if (PendingMinor.IsValid() && PendingMajor.IsValid())
+	else
 	{
-		Type = PendingMajor->GetType() | PendingMinor->GetType();
+		NotifyTypeChanged();
 	}
+	return true;
 }
 
-bool FAction_Parallel::FinishChildAction(FAction* InAction, EActionResult InResult, const FString& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
+EActionResult FAction_Parallel::JoinChild(int32 Index, EActionResult InResult)
 {
-	if (InAction)
+	const bool bInterrupted = InResult == EActionResult::Abort || InResult == EActionResult::Clean;
+	if (InResult == EActionResult::Success)
 	{
-		TSharedPtr<FAction> Action;
-		if (InAction == Major.Get())
-		{
-			Action = Major;
-			Major.Reset();
-			if (Action->DoFinishAction(InResult, Reason, StopType) == false)
-			{
-				Major = Action;
-				NotifyTypeChanged();
-				return false;
-			}
-			else
-			{
-				NotifyActionFinish(InResult, Reason);
-			}
-		}
-		else if (InAction == Minor.Get())
-		{
-			Action = Minor;
-			Minor.Reset();
-			if (Action->DoFinishAction(InResult, Reason, StopType))
-			{
-				if (bStopSeparateType || (InResult != EActionResult::Abort && InResult != EActionResult::Clean))
-				{
-					NotifyTypeChanged();
-				}
-				else
-				{
-					NotifyActionFinish(InResult, Reason);
-				}
-			}
-			else
-			{
-				Minor = Action;
-				NotifyTypeChanged();
-				return false;
-			}
-		}
+		++NumSucceeded;
 	}
-	return true;
-}
 
+	switch (JoinPolicy)
+	{
+	case EActionJoinPolicy::Major:
+		if (Index == 0)
+			return InResult;
+		break;
+	case EActionJoinPolicy::All:
+		if (InResult == EActionResult::Fail)
+			return InResult;
+		break;
+	case EActionJoinPolicy::Any:
+		if (!bInterrupted)
+			return InResult;
+		break;
+	case EActionJoinPolicy::NOfM:
+		if (NumSucceeded >= RequiredCount)
+			return EActionResult::Success;
+		if (NumSucceeded + NumRunning + NumUnstarted < RequiredCount)
+			return EActionResult::Fail;
+		break;
+	}
+
+	if (bInterrupted && !bStopSeparateType)
+		return InResult;
+	if (NumRunning == 0 && NumUnstarted == 0)
+		return JoinPolicy == EActionJoinPolicy::All ? EActionResult::Success : InResult;
+	return EActionResult::Wait;
+}
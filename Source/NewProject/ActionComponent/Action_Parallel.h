@@ -4,33 +4,81 @@
 
 #include "Action.h"
 
+/** When a parallel action finishes. */
+enum class EActionJoinPolicy : uint8
+{
+	/** Once every child has finished, with the first failure. */
+	All,
+	/** With the first child to finish. */
+	Any,
+	/** With the first child, the others are aborted then. */
+	Major,
+	/** Successfully once RequiredCount children have succeeded, failed once that is out of reach. */
+	NOfM
+};
+
 class NEWPROJECT_API FAction_Parallel : public FAction
 {
+	friend class FAction_Program;
 public:
+	DECLARE_ACTION_CLASS()
+
 	FAction_Parallel() { Type = EActionType::Default; }
 
+	/** Runs InMinor alongside InMajor for as long as InMajor runs. */
 	static TSharedPtr<FAction_Parallel> CreateAction(TSharedPtr<FAction> InMajor, TSharedPtr<FAction> InMinor);
+	/** Children that are themselves not yet executed All or Any parallels with the same policy are merged into this one. */
+	static TSharedPtr<FAction_Parallel> CreateAction(const std::initializer_list<TSharedPtr<FAction>>& InActions, EActionJoinPolicy InJoinPolicy = EActionJoinPolicy::All, int32 InRequiredCount = 1);
+	static TSharedPtr<FAction_Parallel> CreateAction(const TArray<TSharedPtr<FAction>>& InActions, EActionJoinPolicy InJoinPolicy = EActionJoinPolicy::All, int32 InRequiredCount = 1);
+	virtual void ResetAction() override;
+	virtual TSharedPtr<FAction> CloneAction() const override;
+	virtual void RearmAction() override;
+	virtual void RetainFinishedChildren() override;
 
+	/** When set, a child aborted or stopped for its own type leaves the others running, and stopping by type only stops the children of that type. */
 	bool bStopSeparateType = false;
 
-	virtual TArray<const FAction*> GetActiveActions() const override;
+	virtual bool ForEachActiveAction(TFunctionRef<bool(const FAction*)> Visitor) const override;
+	virtual bool NeedsTick() const override;
 
 	virtual FName GetName() const override;
 	virtual FString GetDescription() const override;
 
 protected:
 	virtual EActionResult ExecuteAction() override;
-	virtual bool FinishAction(EActionResult InResult, const FString& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
+	virtual bool FinishAction(EActionResult InResult, const FActionFinishReason& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
 	virtual EActionResult TickAction(float DeltaTime) override;
 
 	virtual void UpdateType() override;
 
-	virtual bool FinishChildAction(FAction* InAction, EActionResult InResult, const FString& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
+	virtual bool FinishChildAction(FAction* InAction, EActionResult InResult, const FActionFinishReason& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
 
-	TSharedPtr<FAction> PendingMajor;
-	TSharedPtr<FAction> PendingMinor;
+	void AddChild(const TSharedPtr<FAction>& InAction);
+	/** Copies everything but the concrete type into Action, children included. */
+	void CopyTo(FAction_Parallel& Action) const;
 
-	TSharedPtr<FAction> Major;
-	TSharedPtr<FAction> Minor;
-};
+	template<typename RangeType>
+	static TSharedPtr<FAction_Parallel> CreateFromRange(const RangeType& InActions, EActionJoinPolicy InJoinPolicy, int32 InRequiredCount);
 
+	/** Accounts for a finished child, returns Wait while the parallel keeps running or else its own result. */
+	EActionResult JoinChild(int32 Index, EActionResult InResult);
+
+	struct FParallelChild
+	{
+		TSharedPtr<FAction> Action;
+		bool bRunning = false;
+	};
+
+	TArray<FParallelChild, TInlineAllocator<4>> Children;
+
+	EActionJoinPolicy JoinPolicy = EActionJoinPolicy::All;
+	int32 RequiredCount = 1;
+
+	int32 NumRunning = 0;
+	int32 NumSucceeded = 0;
+	/** Children ExecuteAction has not reached yet. */
+	int32 NumUnstarted = 0;
+	bool bStarted = false;
+	/** Set once the outcome is decided, until the owner finishes this action. */
+	bool bJoined = false;
+};
@@ -1,6 +1,7 @@
 // Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
 
 #include "Action_PlayAnimation.h"
+#include "ActionPool.h"
 #include "GameFramework/Character.h"
 #include "Animation/AnimInstance.h"
 #include "VisualLogger.h"
@@ -20,7 +21,7 @@ TSharedPtr<FAction_PlayAnimation> FAction_PlayAnimation::CreateAction(UAnimation
 			return NULL;
 		}
 	}
-	TSharedPtr<FAction_PlayAnimation> Action = MakeShareable(new FAction_PlayAnimation());
+	TSharedPtr<FAction_PlayAnimation> Action = TActionPool<FAction_PlayAnimation>::Acquire();
 	if (Action.IsValid())
 	{
 		Action->AnimationToPlay = InAnimationToPlay;
@@ -35,9 +36,25 @@ TSharedPtr<FAction_PlayAnimation> FAction_PlayAnimation::CreateAction(UAnimation
 	return Action;
 }
 
+void FAction_PlayAnimation::ResetAction()
+{
+	*this = FAction_PlayAnimation();
+}
+
+TSharedPtr<FAction> FAction_PlayAnimation::CloneAction() const
+{
+	return TActionPool<FAction_PlayAnimation>::Clone(*this);
+}
+
+void FAction_PlayAnimation::RearmAction()
+{
+	CurrentTime = 0;
+}
+
 EActionResult FAction_PlayAnimation::ExecuteAction()
 {
 	EActionResult Result = EActionResult::Fail;
+	bBlendingIn = BlendingInDelegate.IsBound();
 
 	if (!GetOwner())
 		return Result;
@@ -48,7 +65,7 @@ EActionResult FAction_PlayAnimation::ExecuteAction()
 
 	if (AnimationToPlay.IsValid())
 	{
-		ACharacter* const Character = Cast<ACharacter>(GetOwner());
+		ACharacter* const Character = GetOwnerContext().Character;
 		if (Character)
 		{
 			CachedSkelMesh = Character->GetMesh();
@@ -56,7 +73,7 @@ EActionResult FAction_PlayAnimation::ExecuteAction()
 		}
 		else
 		{
-			CachedSkelMesh = GetOwner()->FindComponentByClass<USkeletalMeshComponent>();
+			CachedSkelMesh = GetOwnerContext().Mesh;
 		}
 
 		if (CachedSkelMesh.IsValid())
@@ -229,10 +246,13 @@ EActionResult FAction_PlayAnimation::ExecuteAction()
 	return Result;
 }
 
-bool FAction_PlayAnimation::FinishAction(EActionResult InResult, const FString& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
+bool FAction_PlayAnimation::FinishAction(EActionResult InResult, const FActionFinishReason& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
 {
-	BlendingInDelegate.ExecuteIfBound(this, InResult);
-	BlendingInDelegate.Unbind();
+	if (bBlendingIn)
+	{
+		bBlendingIn = false;
+		BlendingInDelegate.ExecuteIfBound(this, InResult);
+	}
 	if (CachedSkelMesh.IsValid())
 	{
 		UAnimInstance *AnimInst = CachedSkelMesh->GetAnimInstance();
@@ -280,14 +300,14 @@ bool FAction_PlayAnimation::FinishAction(EActionResult InResult, const FString&
 EActionResult FAction_PlayAnimation::TickAction(float DeltaTime)
 {
 	CurrentTime += DeltaTime;
-	if (CurrentTime > BlendingInTime)
+	if (bBlendingIn && CurrentTime > BlendingInTime)
 	{
+		bBlendingIn = false;
 		BlendingInDelegate.ExecuteIfBound(this, EActionResult::Success);
-		BlendingInDelegate.Unbind();
 	}
 	if (bStopWhenMoving)
 	{
-		ACharacter * const Character = Cast<ACharacter>(GetOwner());
+		ACharacter * const Character = GetOwnerContext().Character;
 		if (Character)
 		{
 			if (LastVelocity != Character->GetCharacterMovement()->Velocity)
@@ -301,6 +321,11 @@ EActionResult FAction_PlayAnimation::TickAction(float DeltaTime)
 
 }
 
+bool FAction_PlayAnimation::NeedsTick() const
+{
+	return bBlendingIn || bStopWhenMoving;
+}
+
 void FAction_PlayAnimation::MontageFinished(UAnimMontage *Montage, bool bInterrupted)
 {
 	if (bHasUnbinded == false)
@@ -319,30 +344,22 @@ bool FAction_PlayAnimation::CanPlayAnimation(FName GroupName)
 	if (GetActionComponent() == false)
 		return false;
 
-	for (const auto& Pair : GetActionComponent()->GetAllActions())
+	if (!GetActionComponent()->IsContainType(EActionType::Animation))
+		return true;
+
+	for (const FAction* ActiveAction : GetActionComponent()->GetActiveLeafActions())
 	{
-		if (FAction::TypeIsAType(Pair.Key, EActionType::Animation))
+		if (ActiveAction->GetType() == EActionType::Animation)
 		{
-			const auto& Array = Pair.Value;
-			for (int32 i = 0; i < Array.Num(); i++)
+			const FAction_PlayAnimation* Ani = static_cast<const FAction_PlayAnimation*>(ActiveAction);
+			if (Ani && Ani->AnimMontage.IsValid())
 			{
-				TArray<const FAction*> ActiveActions = Array[i]->GetActiveActions();
-				for (int32 j = 0; j < ActiveActions.Num(); j++)
+				if (Ani->AnimMontage->GetGroupName() == GroupName)
 				{
-					if (ActiveActions[j]->GetType() == EActionType::Animation)
+					if (Ani->Priority < Priority)
 					{
-						const FAction_PlayAnimation* Ani = static_cast<const FAction_PlayAnimation*>(ActiveActions[j]);
-						if (Ani && Ani->AnimMontage.IsValid())
-						{
-							if (Ani->AnimMontage->GetGroupName() == GroupName)
-							{
-								if (Ani->Priority < Priority)
-								{
-									UE_VLOG(GetOwner(), LogAction_PlayAnimation, Warning, TEXT("Animation %s has lower Priority than current Animation %s"), *AnimationToPlay->GetPathName(), *Ani->AnimationToPlay->GetPathName());
-									return false;
-								}
-							}
-						}
+						UE_VLOG(GetOwner(), LogAction_PlayAnimation, Warning, TEXT("Animation %s has lower Priority than current Animation %s"), *AnimationToPlay->GetPathName(), *Ani->AnimationToPlay->GetPathName());
+						return false;
 					}
 				}
 			}
@@ -16,13 +16,19 @@ class NEWPROJECT_API FAction_PlayAnimation : public FAction
 	DECLARE_DELEGATE_TwoParams(FOnBlendingInDelegate, FAction*, EActionResult);
 
 public:
+	DECLARE_ACTION_CLASS()
+
 	FAction_PlayAnimation() { Type = EActionType::Animation; }
 
 	static TSharedPtr<FAction_PlayAnimation> CreateAction(UAnimationAsset *InAnimationToPlay, float InPlayRate = 1.0f, float InBlendInTime = -1.0f, float InBlendOutTime = -1.0f, bool InbLooping = false, EAction_AnimationPriority InPriority = EAction_AnimationPriority::Normal, FName InSlotNodeName = NAME_None, bool InbNonBlocking = false);
+	virtual void ResetAction() override;
+	virtual TSharedPtr<FAction> CloneAction() const override;
+	virtual void RearmAction() override;
 
 	virtual EActionResult ExecuteAction() override;
-	virtual bool FinishAction(EActionResult InResult, const FString& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
+	virtual bool FinishAction(EActionResult InResult, const FActionFinishReason& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
 	virtual EActionResult TickAction(float DeltaTime) override;
+	virtual bool NeedsTick() const override;
 	virtual void MontageFinished(UAnimMontage *Montage, bool bInterrupted);
 
 	FOnBlendingInDelegate BlendingInDelegate;
@@ -61,5 +67,7 @@ private:
 
 	float CurrentTime = 0;
 	float BlendingInTime = 0;
+	/** Set while BlendingInDelegate is still owed its call, the binding itself is kept so a rearmed run fires it again. */
+	bool bBlendingIn = false;
 };
 
@@ -1,6 +1,7 @@
 // Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
 
 #include "Action_PlayRootMotion.h"
+#include "ActionPool.h"
 #include "Animation/AnimMontage.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "GameFramework/Character.h"
@@ -18,7 +19,7 @@ TSharedPtr<FAction_PlayRootMotion> FAction_PlayRootMotion::CreateAction(UAnimMon
 	if (InAnimMontage->HasRootMotion() == false)
 		return nullptr;
 
-	TSharedPtr<FAction_PlayRootMotion> Action = MakeShareable(new FAction_PlayRootMotion());
+	TSharedPtr<FAction_PlayRootMotion> Action = TActionPool<FAction_PlayRootMotion>::Acquire();
 	if (Action.IsValid())
 	{
 		Action->AnimMontage = InAnimMontage;
@@ -32,10 +33,28 @@ TSharedPtr<FAction_PlayRootMotion> FAction_PlayRootMotion::CreateAction(UAnimMon
 	return Action;
 }
 
+void FAction_PlayRootMotion::ResetAction()
+{
+	*this = FAction_PlayRootMotion();
+}
+
+TSharedPtr<FAction> FAction_PlayRootMotion::CloneAction() const
+{
+	return TActionPool<FAction_PlayRootMotion>::Clone(*this);
+}
+
+void FAction_PlayRootMotion::RearmAction()
+{
+	CurrentTime = 0;
+	MoveHasAbort = false;
+	bHasRecoverMovementMode = false;
+}
+
 EActionResult FAction_PlayRootMotion::ExecuteAction()
 {
 	EActionResult Result = EActionResult::Fail;
-	ACharacter *Character = Cast<ACharacter>(GetOwner());
+	bBlendingIn = BlendingInDelegate.IsBound();
+	ACharacter *Character = GetOwnerContext().Character;
 	UCharacterMovementComponent *MovementComp = nullptr;
 	if (Character)
 	{
@@ -55,7 +74,7 @@ EActionResult FAction_PlayRootMotion::ExecuteAction()
 		}
 		else
 		{
-			CachedSkelMesh = GetOwner()->FindComponentByClass<USkeletalMeshComponent>();
+			CachedSkelMesh = GetOwnerContext().Mesh;
 		}
 
 		if (CachedSkelMesh.IsValid())
@@ -165,11 +184,14 @@ EActionResult FAction_PlayRootMotion::ExecuteAction()
 	return Result;
 }
 
-bool FAction_PlayRootMotion::FinishAction(EActionResult InResult, const FString& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
+bool FAction_PlayRootMotion::FinishAction(EActionResult InResult, const FActionFinishReason& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
 {
-	BlendingInDelegate.ExecuteIfBound(this, InResult);
-	BlendingInDelegate.Unbind();
-	ACharacter *Character = Cast<ACharacter>(GetOwner());
+	if (bBlendingIn)
+	{
+		bBlendingIn = false;
+		BlendingInDelegate.ExecuteIfBound(this, InResult);
+	}
+	ACharacter *Character = GetOwnerContext().Character;
 	if (Character)
 	{
 		UAnimInstance *AnimInst = CachedSkelMesh->GetAnimInstance();
@@ -208,16 +230,16 @@ bool FAction_PlayRootMotion::FinishAction(EActionResult InResult, const FString&
 EActionResult FAction_PlayRootMotion::TickAction(float DeltaTime)
 {
 	CurrentTime += DeltaTime;
-	if (CurrentTime > BlendInTime)
+	if (bBlendingIn && CurrentTime > BlendInTime)
 	{
+		bBlendingIn = false;
 		BlendingInDelegate.ExecuteIfBound(this, EActionResult::Success);
-		BlendingInDelegate.Unbind();
 	}
 	if (bLooping == false && CurrentTime > Duration * RecoverMovementModeTime * 1.01f)
 	{
 		RecoverMoveStatue();
 	}
-	ACharacter *Character = Cast<ACharacter>(GetOwner());
+	ACharacter *Character = GetOwnerContext().Character;
 	if (Character)
 	{
 		UCharacterMovementComponent *Movement = Character->GetCharacterMovement();
@@ -231,9 +253,14 @@ EActionResult FAction_PlayRootMotion::TickAction(float DeltaTime)
 	return EActionResult::Wait;
 }
 
+bool FAction_PlayRootMotion::NeedsTick() const
+{
+	return bBlendingIn || (bLooping == false && bHasRecoverMovementMode == false);
+}
+
 float FAction_PlayRootMotion::GetTimeRadio() const
 {
-	ACharacter *Character = Cast<ACharacter>(GetOwner());
+	ACharacter *Character = GetOwnerContext().Character;
 	if (Character)
 	{
 		UAnimInstance *AnimInst = CachedSkelMesh->GetAnimInstance();
@@ -290,7 +317,7 @@ void FAction_PlayRootMotion::RecoverMoveStatue()
 	if (bHasRecoverMovementMode == false)
 	{
 		bHasRecoverMovementMode = true;
-		ACharacter *Character = Cast<ACharacter>(GetOwner());
+		ACharacter *Character = GetOwnerContext().Character;
 		if (Character)
 		{
 			UCharacterMovementComponent *MovementComp = Character->GetCharacterMovement();
@@ -16,12 +16,18 @@ class NEWPROJECT_API FAction_PlayRootMotion : public FAction
 	DECLARE_DELEGATE_TwoParams(FOnBlendingInDelegate, FAction*, EActionResult);
 
 public:
+	DECLARE_ACTION_CLASS()
+
 	FAction_PlayRootMotion() { Type = (EActionType::Animation | EActionType::Move | EActionType::Rotate); }
 
 	static TSharedPtr<FAction_PlayRootMotion> CreateAction(UAnimMontage* InAnimMontage, float InPlayRate = 1.0f, float InBlendInTime = -1.0f, float InBlendOutTime = -1.0f, bool InbLooping = false, FName InSlotNodeName = NAME_None, bool InbNonBlocking = false);
+	virtual void ResetAction() override;
+	virtual TSharedPtr<FAction> CloneAction() const override;
+	virtual void RearmAction() override;
 	virtual EActionResult ExecuteAction() override;
-	virtual bool FinishAction(EActionResult InResult, const FString& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
+	virtual bool FinishAction(EActionResult InResult, const FActionFinishReason& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
 	virtual EActionResult TickAction(float DeltaTime) override;
+	virtual bool NeedsTick() const override;
 	virtual float GetTimeRadio() const override;
 	virtual void RootMotionFinished(UAnimMontage* Montage, bool bInterrupted);
 
@@ -67,5 +73,7 @@ protected:
 
 	float CurrentTime = 0;
 	bool bHasRecoverMovementMode = false;
+	/** Set while BlendingInDelegate is still owed its call, the binding itself is kept so a rearmed run fires it again. */
+	bool bBlendingIn = false;
 };
 
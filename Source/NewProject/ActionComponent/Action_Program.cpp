@@ -0,0 +1,456 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "Action_Program.h"
+#include "Action_Sequence.h"
+#include "ActionPool.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Program Instructions"), STAT_ActionProgramInstructions, STATGROUP_ActionComponent);
+
+/** What FAction_Parallel finishes its interrupted children with, Clean passes through so teardown stays silent. */
+static EActionResult GetInterruptResult(EActionResult InResult)
+{
+	return InResult == EActionResult::Clean ? EActionResult::Clean : EActionResult::Abort;
+}
+
+TSharedPtr<FAction_Program> FAction_Program::Compile(const TSharedPtr<FAction>& InRoot)
+{
+	if (!InRoot.IsValid())
+		return nullptr;
+
+	TSharedPtr<FAction_Program> Program = TActionPool<FAction_Program>::Acquire();
+	if (Program.IsValid())
+	{
+		Program->ActionPriority = InRoot->ActionPriority;
+		Program->QueueTimeout = InRoot->QueueTimeout;
+
+		Program->Threads.Add({ 0, INDEX_NONE, 0 });
+		Program->CompileNode(InRoot, 0, INDEX_NONE);
+		Program->Code.Add({ EActionOp::End, INDEX_NONE });
+
+		Program->ThreadPCs.SetNumZeroed(Program->Threads.Num());
+		Program->ForkStates.SetNum(Program->Forks.Num());
+		Program->LeafStates.SetNum(Program->Leaves.Num());
+		Program->NotifyTypeChanged();
+	}
+	return Program;
+}
+
+void FAction_Program::ResetAction()
+{
+	*this = FAction_Program();
+}
+
+TSharedPtr<FAction> FAction_Program::CloneAction() const
+{
+	TSharedPtr<FAction_Program> Action = TActionPool<FAction_Program>::Clone(*this);
+	if (Action.IsValid())
+	{
+		for (int32 LeafIndex = 0; LeafIndex < Action->Leaves.Num(); ++LeafIndex)
+		{
+			TSharedPtr<FAction>& Leaf = Action->Leaves[LeafIndex];
+			Leaf = Leaf->CloneAction();
+			Leaf->ParentAction = Action;
+			Leaf->IndexInParent = LeafIndex;
+		}
+	}
+	return Action;
+}
+
+void FAction_Program::RearmAction()
+{
+	for (int32 LeafIndex = 0; LeafIndex < Leaves.Num(); ++LeafIndex)
+	{
+		Leaves[LeafIndex]->RearmAction();
+		LeafStates[LeafIndex] = FLeafState();
+	}
+	bStarted = false;
+	UpdateType();
+}
+
+void FAction_Program::RetainFinishedChildren()
+{
+	for (const TSharedPtr<FAction>& Leaf : Leaves)
+	{
+		Leaf->RetainFinishedChildren();
+	}
+}
+
+void FAction_Program::CompileNode(const TSharedPtr<FAction>& Node, int32 ThreadIndex, int32 MajorFork)
+{
+	if (!Node.IsValid())
+		return;
+
+	// Only plain composites dissolve into the program, hooks, a completion or a queue setting would be lost with them.
+	if (Node->GetClassId() == FAction_Sequence::StaticClassId() && Node->IsPlain())
+	{
+		for (const TSharedPtr<FAction>& Child : static_cast<FAction_Sequence*>(Node.Get())->Sequence)
+		{
+			CompileNode(Child, ThreadIndex, MajorFork);
+		}
+		return;
+	}
+
+	FAction_Parallel* Parallel = Node->GetClassId() == FAction_Parallel::StaticClassId() ? static_cast<FAction_Parallel*>(Node.Get()) : nullptr;
+	if (Parallel && Parallel->Children.Num() > 0 && !Parallel->bStopSeparateType && Node->IsPlain())
+	{
+		const int32 ForkIndex = Forks.AddDefaulted();
+		const int32 NumBranches = Parallel->Children.Num();
+		const int32 FirstBranch = BranchThreads.AddUninitialized(NumBranches);
+		const int32 FirstLeaf = Leaves.Num();
+		const bool bMajor = Parallel->JoinPolicy == EActionJoinPolicy::Major;
+		Code.Add({ EActionOp::Fork, ForkIndex });
+
+		for (int32 Branch = 0; Branch < NumBranches; ++Branch)
+		{
+			const int32 BranchThread = Threads.Add({ Code.Num(), ForkIndex, Branch });
+			BranchThreads[FirstBranch + Branch] = BranchThread;
+			CompileNode(Parallel->Children[Branch].Action, BranchThread, bMajor && Branch == 0 ? ForkIndex : MajorFork);
+			Code.Add({ EActionOp::EndBranch, ForkIndex });
+		}
+
+		FForkInfo& Fork = Forks[ForkIndex];
+		Fork.Policy = Parallel->JoinPolicy;
+		Fork.RequiredCount = Parallel->RequiredCount;
+		Fork.OwnerThread = ThreadIndex;
+		Fork.JoinPC = Code.Add({ EActionOp::Join, ForkIndex });
+		Fork.FirstBranch = FirstBranch;
+		Fork.NumBranches = NumBranches;
+		Fork.FirstLeaf = FirstLeaf;
+		Fork.EndLeaf = Leaves.Num();
+		return;
+	}
+
+	const int32 LeafIndex = Leaves.Add(Node);
+	LeafInfos.Add({ ThreadIndex, MajorFork });
+	Node->ParentAction = AsShared();
+	Node->IndexInParent = LeafIndex;
+	Code.Add({ EActionOp::Step, LeafIndex });
+}
+
+EActionType FAction_Program::GetInitialType(int32 PC) const
+{
+	const FActionInstruction& Instruction = Code[PC];
+	if (Instruction.Op == EActionOp::Step)
+		return Leaves[Instruction.Operand]->GetType();
+	if (Instruction.Op != EActionOp::Fork)
+		return EActionType::Default;
+
+	EActionType InitialType = EActionType::Default;
+	const FForkInfo& Fork = Forks[Instruction.Operand];
+	for (int32 Branch = 0; Branch < Fork.NumBranches; ++Branch)
+	{
+		InitialType |= GetInitialType(Threads[BranchThreads[Fork.FirstBranch + Branch]].StartPC);
+	}
+	return InitialType;
+}
+
+bool FAction_Program::ForEachActiveAction(TFunctionRef<bool(const FAction*)> Visitor) const
+{
+	for (int32 LeafIndex = 0; LeafIndex < Leaves.Num(); ++LeafIndex)
+	{
+		if (LeafStates[LeafIndex].bRunning && !Leaves[LeafIndex]->ForEachActiveAction(Visitor))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FAction_Program::NeedsTick() const
+{
+	for (int32 LeafIndex = 0; LeafIndex < Leaves.Num(); ++LeafIndex)
+	{
+		if (LeafStates[LeafIndex].bRunning && !LeafStates[LeafIndex].bHeld && Leaves[LeafIndex]->NeedsTick())
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+FName FAction_Program::GetName() const
+{
+	return TEXT("Action_Program");
+}
+
+FString FAction_Program::GetDescription() const
+{
+	FString LeavesString;
+	for (const TSharedPtr<FAction>& Leaf : Leaves)
+	{
+		LeavesString += Leaf->GetDescription() + TEXT(", ");
+	}
+	LeavesString.RemoveFromEnd(TEXT(", "));
+	return FString::Printf(TEXT("%s (Instructions:%d, Leaves:{%s})"), *GetName().ToString(), Code.Num(), *LeavesString);
+}
+
+EActionResult FAction_Program::ExecuteAction()
+{
+	bStarted = true;
+	for (FLeafState& LeafState : LeafStates)
+	{
+		LeafState = FLeafState();
+	}
+	ThreadPCs[0] = 0;
+
+	const EActionResult Result = RunThread(0);
+	NotifyTypeChanged();
+	return Result;
+}
+
+EActionResult FAction_Program::RunThread(int32 ThreadIndex)
+{
+	for (;;)
+	{
+		INC_DWORD_STAT(STAT_ActionProgramInstructions);
+		const FActionInstruction& Instruction = Code[ThreadPCs[ThreadIndex]];
+		switch (Instruction.Op)
+		{
+		case EActionOp::Step:
+		{
+			const EActionResult Result = StartLeaf(Instruction.Operand);
+			if (Result != EActionResult::Success)
+				return Result;
+			break;
+		}
+		case EActionOp::Fork:
+		{
+			const int32 ForkIndex = Instruction.Operand;
+			const EActionResult Result = StartFork(ForkIndex);
+			ThreadPCs[ThreadIndex] = Forks[ForkIndex].JoinPC;
+			if (Result != EActionResult::Success)
+				return Result;
+			break;
+		}
+		case EActionOp::Join:
+			break;
+		case EActionOp::EndBranch:
+		case EActionOp::End:
+			return EActionResult::Success;
+		}
+		++ThreadPCs[ThreadIndex];
+	}
+}
+
+EActionResult FAction_Program::StartLeaf(int32 LeafIndex)
+{
+	FAction* Leaf = Leaves[LeafIndex].Get();
+	Leaf->SetActionComponent(GetActionComponent());
+	Leaf->SetOwner(GetOwner());
+	const EActionResult Result = Leaf->DoExecuteAction();
+	if (Result == EActionResult::Wait)
+	{
+		LeafStates[LeafIndex].bRunning = true;
+		LeafStates[LeafIndex].StartSerial = TickSerial;
+	}
+	return Result;
+}
+
+EActionResult FAction_Program::StartFork(int32 ForkIndex)
+{
+	const FForkInfo& Fork = Forks[ForkIndex];
+	FForkState& State = ForkStates[ForkIndex];
+	State = FForkState();
+	State.NumUnstarted = Fork.NumBranches;
+	for (int32 Branch = 0; Branch < Fork.NumBranches; ++Branch)
+	{
+		const int32 BranchThread = BranchThreads[Fork.FirstBranch + Branch];
+		--State.NumUnstarted;
+		ThreadPCs[BranchThread] = Threads[BranchThread].StartPC;
+		EActionResult Result = RunThread(BranchThread);
+		if (Result == EActionResult::Wait)
+		{
+			++State.NumRunning;
+			continue;
+		}
+
+		Result = JoinBranch(ForkIndex, Branch, Result);
+		if (Result != EActionResult::Wait)
+		{
+			State.NumUnstarted = 0;
+			// A parallel aborts its other children when it is decided while starting.
+			if (!StopLeaves(Fork.FirstLeaf, Fork.EndLeaf, EActionResult::Abort, EActionFinishReason::UnKnown))
+				return EActionResult::Wait;
+			return Result;
+		}
+	}
+	return EActionResult::Wait;
+}
+
+EActionResult FAction_Program::JoinBranch(int32 ForkIndex, int32 Branch, EActionResult InResult)
+{
+	const FForkInfo& Fork = Forks[ForkIndex];
+	FForkState& State = ForkStates[ForkIndex];
+	const bool bInterrupted = InResult == EActionResult::Abort || InResult == EActionResult::Clean;
+	if (InResult == EActionResult::Success)
+	{
+		++State.NumSucceeded;
+	}
+
+	switch (Fork.Policy)
+	{
+	case EActionJoinPolicy::Major:
+		if (Branch == 0)
+			return InResult;
+		break;
+	case EActionJoinPolicy::All:
+		if (InResult == EActionResult::Fail)
+			return InResult;
+		break;
+	case EActionJoinPolicy::Any:
+		if (!bInterrupted)
+			return InResult;
+		break;
+	case EActionJoinPolicy::NOfM:
+		if (State.NumSucceeded >= Fork.RequiredCount)
+			return EActionResult::Success;
+		if (State.NumSucceeded + State.NumRunning + State.NumUnstarted < Fork.RequiredCount)
+			return EActionResult::Fail;
+		break;
+	}
+
+	if (bInterrupted)
+		return InResult;
+	if (State.NumRunning == 0 && State.NumUnstarted == 0)
+		return Fork.Policy == EActionJoinPolicy::All ? EActionResult::Success : InResult;
+	return EActionResult::Wait;
+}
+
+bool FAction_Program::StopLeaves(int32 FirstLeaf, int32 EndLeaf, EActionResult InResult, const FActionFinishReason& Reason)
+{
+	bool bStopped = true;
+	for (int32 LeafIndex = FirstLeaf; LeafIndex < EndLeaf; ++LeafIndex)
+	{
+		FLeafState& LeafState = LeafStates[LeafIndex];
+		if (!LeafState.bRunning)
+			continue;
+
+		LeafState.bRunning = false;
+		if (Leaves[LeafIndex]->DoFinishAction(GetInterruptResult(InResult), Reason) == false)
+		{
+			LeafState.bRunning = true;
+			LeafState.bHeld = true;
+			bStopped = false;
+		}
+	}
+	return bStopped;
+}
+
+bool FAction_Program::FinishAction(EActionResult InResult, const FActionFinishReason& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
+{
+	bool bFinished = true;
+	for (int32 LeafIndex = 0; LeafIndex < Leaves.Num(); ++LeafIndex)
+	{
+		if (!LeafStates[LeafIndex].bRunning)
+			continue;
+
+		// Within a fork the leaf gets what a parallel passes its running children, else what its sequence passes on.
+		const FLeafInfo& Info = LeafInfos[LeafIndex];
+		const bool bInFork = Threads[Info.Thread].Fork != INDEX_NONE;
+		LeafStates[LeafIndex].bRunning = false;
+		if (Leaves[LeafIndex]->DoFinishAction(bInFork ? GetInterruptResult(InResult) : InResult, Reason, StopType) == false)
+		{
+			LeafStates[LeafIndex].bRunning = true;
+			bFinished = false;
+			if (Info.MajorFork != INDEX_NONE)
+			{
+				LeafIndex = FMath::Max(LeafIndex, Forks[Info.MajorFork].EndLeaf - 1);
+			}
+		}
+	}
+
+	if (!bFinished)
+	{
+		NotifyTypeChanged();
+	}
+	return bFinished;
+}
+
+EActionResult FAction_Program::TickAction(float DeltaTime)
+{
+	++TickSerial;
+	for (int32 LeafIndex = 0; LeafIndex < Leaves.Num(); ++LeafIndex)
+	{
+		const FLeafState& LeafState = LeafStates[LeafIndex];
+		if (!LeafState.bRunning || LeafState.bHeld || LeafState.StartSerial == TickSerial)
+			continue;
+
+		FAction* Leaf = Leaves[LeafIndex].Get();
+		const EActionResult Result = Leaf->DoTickAction(DeltaTime);
+		if (Result != EActionResult::Wait)
+		{
+			FinishChildAction(Leaf, Result);
+		}
+	}
+	return EActionResult::Wait;
+}
+
+void FAction_Program::UpdateType()
+{
+	if (!bStarted)
+	{
+		Type = Code.Num() > 0 ? GetInitialType(0) : EActionType::Default;
+		return;
+	}
+
+	Type = EActionType::Default;
+	for (int32 LeafIndex = 0; LeafIndex < Leaves.Num(); ++LeafIndex)
+	{
+		if (LeafStates[LeafIndex].bRunning)
+		{
+			Type |= Leaves[LeafIndex]->GetType();
+		}
+	}
+}
+
+bool FAction_Program::FinishChildAction(FAction* InAction, EActionResult InResult, const FActionFinishReason& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
+{
+	if (!InAction || !Leaves.IsValidIndex(InAction->IndexInParent))
+		return true;
+
+	const int32 LeafIndex = InAction->IndexInParent;
+	if (!LeafStates[LeafIndex].bRunning || Leaves[LeafIndex].Get() != InAction)
+		return true;
+
+	LeafStates[LeafIndex].bRunning = false;
+	if (InAction->DoFinishAction(InResult, Reason, StopType) == false)
+	{
+		LeafStates[LeafIndex].bRunning = true;
+		NotifyTypeChanged();
+		return false;
+	}
+
+	int32 ThreadIndex = LeafInfos[LeafIndex].Thread;
+	EActionResult Result = InResult;
+	for (;;)
+	{
+		if (Result == EActionResult::Success)
+		{
+			++ThreadPCs[ThreadIndex];
+			Result = RunThread(ThreadIndex);
+		}
+		if (Result == EActionResult::Wait)
+			break;
+
+		const FThreadInfo& Thread = Threads[ThreadIndex];
+		if (Thread.Fork == INDEX_NONE)
+		{
+			NotifyActionFinish(Result, Reason);
+			return true;
+		}
+
+		const FForkInfo& Fork = Forks[Thread.Fork];
+		--ForkStates[Thread.Fork].NumRunning;
+		Result = JoinBranch(Thread.Fork, Thread.Branch, Result);
+		if (Result == EActionResult::Wait)
+			break;
+
+		// The owner thread stays on the join while a leaf refuses to stop, as a sequence stays on a parallel refusing to finish.
+		if (!StopLeaves(Fork.FirstLeaf, Fork.EndLeaf, Result, Reason))
+			break;
+		ThreadIndex = Fork.OwnerThread;
+	}
+
+	NotifyTypeChanged();
+	return true;
+}
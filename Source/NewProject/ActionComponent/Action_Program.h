@@ -0,0 +1,135 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Action.h"
+#include "Action_Parallel.h"
+
+enum class EActionOp : uint8
+{
+	/** Runs leaf Operand, the thread ends unless it succeeds. */
+	Step,
+	/** Starts every branch of fork Operand, the thread then waits on the fork's Join. */
+	Fork,
+	/** Ends a branch of fork Operand successfully. */
+	EndBranch,
+	/** Where the forking thread resumes once fork Operand is decided. */
+	Join,
+	/** Ends the program successfully. */
+	End
+};
+
+struct FActionInstruction
+{
+	EActionOp Op;
+	int32 Operand;
+};
+
+/**
+ * A tree of sequences and parallels compiled into one flat instruction array.
+ * Its leaves are stored contiguously and report straight to the program, which advances every thread
+ * in a loop, so neither ticking nor finishing a leaf goes through the composites it was built from.
+ */
+class NEWPROJECT_API FAction_Program : public FAction
+{
+public:
+	DECLARE_ACTION_CLASS()
+
+	/**
+	 * Takes over the leaves of InRoot, a tree that has not been executed yet and must not be used afterwards.
+	 * Sequences and parallels that are not plain (see FAction::IsPlain), and parallels stopping by type, are kept as opaque leaves.
+	 */
+	static TSharedPtr<FAction_Program> Compile(const TSharedPtr<FAction>& InRoot);
+	virtual void ResetAction() override;
+	virtual TSharedPtr<FAction> CloneAction() const override;
+	virtual void RearmAction() override;
+	virtual void RetainFinishedChildren() override;
+
+	virtual bool ForEachActiveAction(TFunctionRef<bool(const FAction*)> Visitor) const override;
+	virtual bool NeedsTick() const override;
+
+	virtual FName GetName() const override;
+	virtual FString GetDescription() const override;
+
+protected:
+	virtual EActionResult ExecuteAction() override;
+	virtual bool FinishAction(EActionResult InResult, const FActionFinishReason& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
+	virtual EActionResult TickAction(float DeltaTime) override;
+
+	virtual void UpdateType() override;
+
+	virtual bool FinishChildAction(FAction* InAction, EActionResult InResult, const FActionFinishReason& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
+
+private:
+	struct FForkInfo
+	{
+		EActionJoinPolicy Policy;
+		int32 RequiredCount;
+		/** Thread that forked, it waits on JoinPC. */
+		int32 OwnerThread;
+		int32 JoinPC;
+		/** Range of BranchThreads holding the thread of each branch. */
+		int32 FirstBranch;
+		int32 NumBranches;
+		/** Leaves of every branch, nested forks included. */
+		int32 FirstLeaf;
+		int32 EndLeaf;
+	};
+
+	struct FForkState
+	{
+		int32 NumRunning = 0;
+		int32 NumSucceeded = 0;
+		int32 NumUnstarted = 0;
+	};
+
+	struct FThreadInfo
+	{
+		int32 StartPC;
+		/** Fork this thread is a branch of, INDEX_NONE for the main thread. */
+		int32 Fork;
+		int32 Branch;
+	};
+
+	struct FLeafInfo
+	{
+		int32 Thread;
+		/** Innermost Major fork whose first branch holds this leaf, its other branches are left alone when the leaf refuses to stop. */
+		int32 MajorFork;
+	};
+
+	struct FLeafState
+	{
+		bool bRunning = false;
+		/** Refused to stop when its fork was decided, it is no longer ticked and waits for the program to be finished. */
+		bool bHeld = false;
+		/** TickSerial when the leaf started, a leaf is first ticked the tick after it started. */
+		uint32 StartSerial = 0;
+	};
+
+	void CompileNode(const TSharedPtr<FAction>& Node, int32 ThreadIndex, int32 MajorFork);
+	EActionType GetInitialType(int32 PC) const;
+
+	/** Runs ThreadIndex from its PC until it waits or ends, returns Wait or the thread's result. */
+	EActionResult RunThread(int32 ThreadIndex);
+	EActionResult StartLeaf(int32 LeafIndex);
+	EActionResult StartFork(int32 ForkIndex);
+	/** Accounts for a finished branch, returns Wait while the fork keeps running or else its result. */
+	EActionResult JoinBranch(int32 ForkIndex, int32 Branch, EActionResult InResult);
+	/** Interrupts the running leaves of a decided fork, returns false when one of them refused and keeps running. */
+	bool StopLeaves(int32 FirstLeaf, int32 EndLeaf, EActionResult InResult, const FActionFinishReason& Reason);
+
+	TArray<FActionInstruction> Code;
+	TArray<FForkInfo> Forks;
+	TArray<int32> BranchThreads;
+	TArray<FThreadInfo> Threads;
+	TArray<TSharedPtr<FAction>> Leaves;
+	TArray<FLeafInfo> LeafInfos;
+
+	TArray<int32> ThreadPCs;
+	TArray<FForkState> ForkStates;
+	TArray<FLeafState> LeafStates;
+
+	uint32 TickSerial = 0;
+	bool bStarted = false;
+};
@@ -0,0 +1,49 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "Action_Race.h"
+#include "ActionPool.h"
+
+TSharedPtr<FAction_Race> FAction_Race::CreateAction(const std::initializer_list<TSharedPtr<FAction>>& InActions)
+{
+	return CreateRaceFromRange(InActions);
+}
+
+TSharedPtr<FAction_Race> FAction_Race::CreateAction(const TArray<TSharedPtr<FAction>>& InActions)
+{
+	return CreateRaceFromRange(InActions);
+}
+
+template<typename RangeType>
+TSharedPtr<FAction_Race> FAction_Race::CreateRaceFromRange(const RangeType& InActions)
+{
+	TSharedPtr<FAction_Race> Action = TActionPool<FAction_Race>::Acquire();
+	if (Action.IsValid())
+	{
+		for (const TSharedPtr<FAction>& SingleAction : InActions)
+		{
+			Action->AddChild(SingleAction);
+		}
+		Action->NotifyTypeChanged();
+	}
+	return Action;
+}
+
+void FAction_Race::ResetAction()
+{
+	*this = FAction_Race();
+}
+
+TSharedPtr<FAction> FAction_Race::CloneAction() const
+{
+	TSharedPtr<FAction_Race> Action = TActionPool<FAction_Race>::Acquire();
+	if (Action.IsValid())
+	{
+		CopyTo(*Action);
+	}
+	return Action;
+}
+
+FName FAction_Race::GetName() const
+{
+	return TEXT("Action_Race");
+}
@@ -0,0 +1,25 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Action_Parallel.h"
+
+/** A parallel won by the first child to finish, every other child is aborted whatever the winner's result. */
+class NEWPROJECT_API FAction_Race : public FAction_Parallel
+{
+public:
+	DECLARE_ACTION_CLASS()
+
+	FAction_Race() { JoinPolicy = EActionJoinPolicy::Any; }
+
+	static TSharedPtr<FAction_Race> CreateAction(const std::initializer_list<TSharedPtr<FAction>>& InActions);
+	static TSharedPtr<FAction_Race> CreateAction(const TArray<TSharedPtr<FAction>>& InActions);
+	virtual void ResetAction() override;
+	virtual TSharedPtr<FAction> CloneAction() const override;
+
+	virtual FName GetName() const override;
+
+protected:
+	template<typename RangeType>
+	static TSharedPtr<FAction_Race> CreateRaceFromRange(const RangeType& InActions);
+};
@@ -0,0 +1,204 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "Action_Repeat.h"
+#include "ActionPool.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Repeat Iterations"), STAT_ActionRepeatIterations, STATGROUP_ActionComponent);
+
+TSharedPtr<FAction_Repeat> FAction_Repeat::CreateAction(TSharedPtr<FAction> InAction, int32 InCount /*= 0*/)
+{
+	if (!InAction.IsValid())
+		return nullptr;
+
+	TSharedPtr<FAction_Repeat> Action = TActionPool<FAction_Repeat>::Acquire();
+	if (Action.IsValid())
+	{
+		Action->Count = InCount;
+		Action->Child = InAction;
+		InAction->ParentAction = Action;
+		// Every iteration rearms the child, so its sequences must keep what they finished.
+		InAction->RetainFinishedChildren();
+		Action->NotifyTypeChanged();
+	}
+	return Action;
+}
+
+void FAction_Repeat::ResetAction()
+{
+	*this = FAction_Repeat();
+}
+
+TSharedPtr<FAction> FAction_Repeat::CloneAction() const
+{
+	TSharedPtr<FAction_Repeat> Action = TActionPool<FAction_Repeat>::Acquire();
+	if (Action.IsValid())
+	{
+		static_cast<FAction&>(*Action) = *this;
+		Action->DetachCopy();
+		Action->Until = Until;
+		Action->Count = Count;
+		Action->Iteration = Iteration;
+		Action->bChildRunning = bChildRunning;
+		Action->bIterationPending = bIterationPending;
+		if (Child.IsValid())
+		{
+			Action->Child = Child->CloneAction();
+			Action->Child->ParentAction = Action;
+		}
+	}
+	return Action;
+}
+
+void FAction_Repeat::RearmAction()
+{
+	if (Child.IsValid())
+	{
+		Child->RearmAction();
+	}
+	Iteration = 0;
+	bChildRunning = false;
+	bIterationPending = false;
+	UpdateType();
+}
+
+void FAction_Repeat::RetainFinishedChildren()
+{
+	if (Child.IsValid())
+	{
+		Child->RetainFinishedChildren();
+	}
+}
+
+bool FAction_Repeat::ForEachActiveAction(TFunctionRef<bool(const FAction*)> Visitor) const
+{
+	return !bChildRunning || Child->ForEachActiveAction(Visitor);
+}
+
+bool FAction_Repeat::NeedsTick() const
+{
+	return bIterationPending || (bChildRunning && Child->NeedsTick());
+}
+
+FName FAction_Repeat::GetName() const
+{
+	return TEXT("Action_Repeat");
+}
+
+FString FAction_Repeat::GetDescription() const
+{
+	return FString::Printf(TEXT("%s (Iteration:%d/%d, Repeat:{%s})"), *GetName().ToString(), Iteration, Count, Child.IsValid() ? *Child->GetDescription() : TEXT(""));
+}
+
+EActionResult FAction_Repeat::ExecuteAction()
+{
+	if (!Child.IsValid())
+		return EActionResult::Fail;
+
+	Iteration = 0;
+	bChildRunning = false;
+	bIterationPending = false;
+	const EActionResult Result = RunIterations();
+	NotifyTypeChanged();
+	return Result;
+}
+
+EActionResult FAction_Repeat::RunIterations()
+{
+	for (int32 NumInstant = 0; NumInstant < MaxInstantIterations; ++NumInstant)
+	{
+		if (Iteration > 0)
+		{
+			if ((Count > 0 && Iteration >= Count) || (Until.IsBound() && Until.Execute(this)))
+				return EActionResult::Success;
+			Child->RearmAction();
+		}
+
+		++Iteration;
+		INC_DWORD_STAT(STAT_ActionRepeatIterations);
+		Child->SetActionComponent(GetActionComponent());
+		Child->SetOwner(GetOwner());
+		const EActionResult Result = Child->DoExecuteAction();
+		if (Result == EActionResult::Wait)
+		{
+			bChildRunning = true;
+			return EActionResult::Wait;
+		}
+		if (Result != EActionResult::Success)
+			return Result;
+	}
+
+	bIterationPending = true;
+	RequestTick();
+	return EActionResult::Wait;
+}
+
+bool FAction_Repeat::FinishAction(EActionResult InResult, const FActionFinishReason& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
+{
+	bIterationPending = false;
+	if (!bChildRunning)
+		return true;
+
+	bChildRunning = false;
+	if (Child->DoFinishAction(InResult, Reason, StopType) == false)
+	{
+		bChildRunning = true;
+		NotifyTypeChanged();
+		return false;
+	}
+	return true;
+}
+
+EActionResult FAction_Repeat::TickAction(float DeltaTime)
+{
+	if (bIterationPending)
+	{
+		bIterationPending = false;
+		const EActionResult Result = RunIterations();
+		NotifyTypeChanged();
+		return Result;
+	}
+
+	if (!bChildRunning)
+		return EActionResult::Abort;
+
+	const EActionResult Result = Child->DoTickAction(DeltaTime);
+	if (Result != EActionResult::Wait)
+	{
+		FinishChildAction(Child.Get(), Result);
+	}
+	return EActionResult::Wait;
+}
+
+void FAction_Repeat::UpdateType()
+{
+	Type = Child.IsValid() ? Child->GetType() : EActionType::Default;
+}
+
+bool FAction_Repeat::FinishChildAction(FAction* InAction, EActionResult InResult, const FActionFinishReason& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
+{
+	if (!InAction || !bChildRunning || InAction != Child.Get())
+		return true;
+
+	bChildRunning = false;
+	if (InAction->DoFinishAction(InResult, Reason, StopType) == false)
+	{
+		bChildRunning = true;
+		NotifyTypeChanged();
+		return false;
+	}
+
+	if (InResult == EActionResult::Success)
+	{
+		InResult = RunIterations();
+	}
+
+	if (InResult != EActionResult::Wait)
+	{
+		NotifyActionFinish(InResult, Reason);
+	}
+	else
+	{
+		NotifyTypeChanged();
+	}
+	return true;
+}
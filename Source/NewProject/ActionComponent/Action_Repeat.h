@@ -0,0 +1,57 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Action.h"
+
+/**
+ * Runs one child over and over, rearming it in place between iterations,
+ * so a loop neither rebuilds its subtree nor rebinds the hooks bound on it.
+ */
+class NEWPROJECT_API FAction_Repeat : public FAction
+{
+	typedef TActionCallback<bool(FAction*)> FUntil;
+
+public:
+	DECLARE_ACTION_CLASS()
+
+	FAction_Repeat() { Type = EActionType::Default; }
+
+	/** Runs InAction InCount times, or until it fails or Until returns true when InCount is not positive. */
+	static TSharedPtr<FAction_Repeat> CreateAction(TSharedPtr<FAction> InAction, int32 InCount = 0);
+	virtual void ResetAction() override;
+	virtual TSharedPtr<FAction> CloneAction() const override;
+	virtual void RearmAction() override;
+	virtual void RetainFinishedChildren() override;
+
+	/** Checked after every successful iteration, the repeat succeeds once it returns true. */
+	FUntil Until;
+
+	virtual bool ForEachActiveAction(TFunctionRef<bool(const FAction*)> Visitor) const override;
+	virtual bool NeedsTick() const override;
+
+	virtual FName GetName() const override;
+	virtual FString GetDescription() const override;
+
+	/** Iterations a child may complete without waiting within one call before the next is left to the following tick. */
+	static const int32 MaxInstantIterations = 64;
+
+protected:
+	virtual EActionResult ExecuteAction() override;
+	virtual bool FinishAction(EActionResult InResult, const FActionFinishReason& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
+	virtual EActionResult TickAction(float DeltaTime) override;
+
+	virtual void UpdateType() override;
+
+	virtual bool FinishChildAction(FAction* InAction, EActionResult InResult, const FActionFinishReason& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
+
+	/** Starts iterations until the child has to wait, returns Wait or the result of the repeat. */
+	EActionResult RunIterations();
+
+	TSharedPtr<FAction> Child;
+	int32 Count = 0;
+	int32 Iteration = 0;
+	bool bChildRunning = false;
+	/** The next iteration was deferred to TickAction after MaxInstantIterations. */
+	bool bIterationPending = false;
+};
@@ -0,0 +1,228 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "Action_Retry.h"
+#include "ActionPool.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Retry Attempts"), STAT_ActionRetryAttempts, STATGROUP_ActionComponent);
+
+TSharedPtr<FAction_Retry> FAction_Retry::CreateAction(TSharedPtr<FAction> InAction, int32 InAttempts, float InBackoff /*= 0.0f*/, float InBackoffMultiplier /*= 1.0f*/)
+{
+	if (!InAction.IsValid())
+		return nullptr;
+
+	TSharedPtr<FAction_Retry> Action = TActionPool<FAction_Retry>::Acquire();
+	if (Action.IsValid())
+	{
+		Action->Attempts = FMath::Max(InAttempts, 1);
+		Action->Backoff = InBackoff;
+		Action->BackoffMultiplier = InBackoffMultiplier;
+		Action->Child = InAction;
+		InAction->ParentAction = Action;
+		// Every attempt rearms the child, so its sequences must keep what they finished.
+		InAction->RetainFinishedChildren();
+		Action->NotifyTypeChanged();
+	}
+	return Action;
+}
+
+void FAction_Retry::ResetAction()
+{
+	*this = FAction_Retry();
+}
+
+TSharedPtr<FAction> FAction_Retry::CloneAction() const
+{
+	TSharedPtr<FAction_Retry> Action = TActionPool<FAction_Retry>::Acquire();
+	if (Action.IsValid())
+	{
+		static_cast<FAction&>(*Action) = *this;
+		Action->DetachCopy();
+		Action->Attempts = Attempts;
+		Action->Backoff = Backoff;
+		Action->BackoffMultiplier = BackoffMultiplier;
+		Action->Attempt = Attempt;
+		Action->bChildRunning = bChildRunning;
+		Action->bRetryPending = bRetryPending;
+		Action->RetryTime = RetryTime;
+		if (Child.IsValid())
+		{
+			Action->Child = Child->CloneAction();
+			Action->Child->ParentAction = Action;
+		}
+	}
+	return Action;
+}
+
+void FAction_Retry::RearmAction()
+{
+	if (Child.IsValid())
+	{
+		Child->RearmAction();
+	}
+	Attempt = 0;
+	bChildRunning = false;
+	bRetryPending = false;
+	RetryTime = 0.0f;
+	UpdateType();
+}
+
+void FAction_Retry::RetainFinishedChildren()
+{
+	if (Child.IsValid())
+	{
+		Child->RetainFinishedChildren();
+	}
+}
+
+bool FAction_Retry::ForEachActiveAction(TFunctionRef<bool(const FAction*)> Visitor) const
+{
+	return !bChildRunning || Child->ForEachActiveAction(Visitor);
+}
+
+bool FAction_Retry::NeedsTick() const
+{
+	return bRetryPending || (bChildRunning && Child->NeedsTick());
+}
+
+FName FAction_Retry::GetName() const
+{
+	return TEXT("Action_Retry");
+}
+
+FString FAction_Retry::GetDescription() const
+{
+	return FString::Printf(TEXT("%s (Attempt:%d/%d, Retry:{%s})"), *GetName().ToString(), Attempt, Attempts, Child.IsValid() ? *Child->GetDescription() : TEXT(""));
+}
+
+EActionResult FAction_Retry::ExecuteAction()
+{
+	if (!Child.IsValid())
+		return EActionResult::Fail;
+
+	Attempt = 0;
+	bChildRunning = false;
+	bRetryPending = false;
+	const EActionResult Result = RunAttempts();
+	NotifyTypeChanged();
+	return Result;
+}
+
+EActionResult FAction_Retry::RunAttempts()
+{
+	for (;;)
+	{
+		if (Attempt > 0)
+		{
+			Child->RearmAction();
+		}
+
+		++Attempt;
+		INC_DWORD_STAT(STAT_ActionRetryAttempts);
+		Child->SetActionComponent(GetActionComponent());
+		Child->SetOwner(GetOwner());
+		const EActionResult Result = Child->DoExecuteAction();
+		if (Result == EActionResult::Wait)
+		{
+			bChildRunning = true;
+			return EActionResult::Wait;
+		}
+
+		bool bDelayed = false;
+		if (!ShouldRetry(Result, bDelayed))
+			return Result;
+		if (bDelayed)
+			return EActionResult::Wait;
+	}
+}
+
+bool FAction_Retry::ShouldRetry(EActionResult InResult, bool& bOutDelayed)
+{
+	bOutDelayed = false;
+	if (InResult != EActionResult::Fail || Attempt >= Attempts)
+		return false;
+
+	const float Delay = Backoff * FMath::Pow(BackoffMultiplier, (float)(Attempt - 1));
+	if (Delay > 0.0f)
+	{
+		RetryTime = GetActionTime() + Delay;
+		bRetryPending = true;
+		bOutDelayed = true;
+		RequestTick();
+	}
+	return true;
+}
+
+bool FAction_Retry::FinishAction(EActionResult InResult, const FActionFinishReason& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
+{
+	bRetryPending = false;
+	if (!bChildRunning)
+		return true;
+
+	bChildRunning = false;
+	if (Child->DoFinishAction(InResult, Reason, StopType) == false)
+	{
+		bChildRunning = true;
+		NotifyTypeChanged();
+		return false;
+	}
+	return true;
+}
+
+EActionResult FAction_Retry::TickAction(float DeltaTime)
+{
+	if (bRetryPending)
+	{
+		if (GetActionTime() < RetryTime)
+			return EActionResult::Wait;
+
+		bRetryPending = false;
+		const EActionResult Result = RunAttempts();
+		NotifyTypeChanged();
+		return Result;
+	}
+
+	if (!bChildRunning)
+		return EActionResult::Abort;
+
+	const EActionResult Result = Child->DoTickAction(DeltaTime);
+	if (Result != EActionResult::Wait)
+	{
+		FinishChildAction(Child.Get(), Result);
+	}
+	return EActionResult::Wait;
+}
+
+void FAction_Retry::UpdateType()
+{
+	Type = Child.IsValid() ? Child->GetType() : EActionType::Default;
+}
+
+bool FAction_Retry::FinishChildAction(FAction* InAction, EActionResult InResult, const FActionFinishReason& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
+{
+	if (!InAction || !bChildRunning || InAction != Child.Get())
+		return true;
+
+	bChildRunning = false;
+	if (InAction->DoFinishAction(InResult, Reason, StopType) == false)
+	{
+		bChildRunning = true;
+		NotifyTypeChanged();
+		return false;
+	}
+
+	bool bDelayed = false;
+	if (ShouldRetry(InResult, bDelayed))
+	{
+		InResult = bDelayed ? EActionResult::Wait : RunAttempts();
+	}
+
+	if (InResult != EActionResult::Wait)
+	{
+		NotifyActionFinish(InResult, Reason);
+	}
+	else
+	{
+		NotifyTypeChanged();
+	}
+	return true;
+}
@@ -0,0 +1,55 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Action.h"
+
+/**
+ * Runs one child again after it fails, rearming it in place, up to a number of attempts.
+ * The wait between attempts is kept on the component's clock instead of by a Wait action.
+ */
+class NEWPROJECT_API FAction_Retry : public FAction
+{
+public:
+	DECLARE_ACTION_CLASS()
+
+	FAction_Retry() { Type = EActionType::Default; }
+
+	/** Tries InAction up to InAttempts times, waiting InBackoff seconds before the first retry and InBackoffMultiplier times longer before each next one. */
+	static TSharedPtr<FAction_Retry> CreateAction(TSharedPtr<FAction> InAction, int32 InAttempts, float InBackoff = 0.0f, float InBackoffMultiplier = 1.0f);
+	virtual void ResetAction() override;
+	virtual TSharedPtr<FAction> CloneAction() const override;
+	virtual void RearmAction() override;
+	virtual void RetainFinishedChildren() override;
+
+	virtual bool ForEachActiveAction(TFunctionRef<bool(const FAction*)> Visitor) const override;
+	virtual bool NeedsTick() const override;
+
+	virtual FName GetName() const override;
+	virtual FString GetDescription() const override;
+
+protected:
+	virtual EActionResult ExecuteAction() override;
+	virtual bool FinishAction(EActionResult InResult, const FActionFinishReason& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
+	virtual EActionResult TickAction(float DeltaTime) override;
+
+	virtual void UpdateType() override;
+
+	virtual bool FinishChildAction(FAction* InAction, EActionResult InResult, const FActionFinishReason& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
+
+	/** Starts attempts until the child has to wait or a retry is delayed, returns Wait or the result of the retry. */
+	EActionResult RunAttempts();
+	/** Whether an attempt that ended with InResult is tried again, delays the retry by the backoff when there is one. */
+	bool ShouldRetry(EActionResult InResult, bool& bOutDelayed);
+
+	TSharedPtr<FAction> Child;
+	int32 Attempts = 1;
+	float Backoff = 0.0f;
+	float BackoffMultiplier = 1.0f;
+
+	int32 Attempt = 0;
+	bool bChildRunning = false;
+	/** A retry waits for RetryTime on the component's clock. */
+	bool bRetryPending = false;
+	float RetryTime = 0.0f;
+};
@@ -1,13 +1,14 @@
 // Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
 
 #include "Action_RootMotionConstant.h"
+#include "ActionPool.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/Character.h"
 
 
 TSharedPtr<FAction_RootMotionConstant> FAction_RootMotionConstant::CreateAction(FVector WorldDirection, float Strength, float Duration /*= -1.0*/, bool bIsAdditive /*= false*/, UCurveFloat* StrengthOverTime /*= nullptr*/, ERootMotionFinishVelocityMode VelocityOnFinishMode /*= ERootMotionFinishVelocityMode::MaintainLastRootMotionVelocity*/, FVector SetVelocityOnFinish /*= FVector::ZeroVector*/, float ClampVelocityOnFinish /*= 0.0f */)
 {
-	TSharedPtr<FAction_RootMotionConstant> Action = MakeShareable(new FAction_RootMotionConstant());
+	TSharedPtr<FAction_RootMotionConstant> Action = TActionPool<FAction_RootMotionConstant>::Acquire();
 
 	if (Action.IsValid())
 	{
@@ -31,10 +32,20 @@ TSharedPtr<FAction_RootMotionConstant> FAction_RootMotionConstant::CreateAction(
 	return Action;
 }
 
+void FAction_RootMotionConstant::ResetAction()
+{
+	*this = FAction_RootMotionConstant();
+}
+
+TSharedPtr<FAction> FAction_RootMotionConstant::CloneAction() const
+{
+	return TActionPool<FAction_RootMotionConstant>::Clone(*this);
+}
+
 EActionResult FAction_RootMotionConstant::ExecuteAction()
 {
 	EActionResult Result = EActionResult::Wait;
-	ACharacter *Character = Cast<ACharacter>(GetOwner());
+	ACharacter *Character = GetOwnerContext().Character;
 	UCharacterMovementComponent *MovementComponent = nullptr;
 	if (Character)
 	{
@@ -60,9 +71,9 @@ EActionResult FAction_RootMotionConstant::ExecuteAction()
 	return Result;
 }
 
-bool FAction_RootMotionConstant::FinishAction(EActionResult InResult, const FString& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
+bool FAction_RootMotionConstant::FinishAction(EActionResult InResult, const FActionFinishReason& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
 {
-	ACharacter *Character = Cast<ACharacter>(GetOwner());
+	ACharacter *Character = GetOwnerContext().Character;
 	UCharacterMovementComponent *MovementComponent = nullptr;
 	if (Character)
 	{
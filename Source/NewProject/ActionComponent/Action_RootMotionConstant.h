@@ -13,6 +13,8 @@ NEWPROJECT_API DECLARE_LOG_CATEGORY_EXTERN(LogAction_RootMotionConstant, Warning
 class NEWPROJECT_API FAction_RootMotionConstant : public FAction_RootMotionForce
 {
 public:
+	DECLARE_ACTION_CLASS()
+
 	FAction_RootMotionConstant() { Type = EActionType::Move; }
 
 	static TSharedPtr<FAction_RootMotionConstant> CreateAction(
@@ -25,10 +27,13 @@ public:
 		FVector SetVelocityOnFinish = FVector::ZeroVector,
 		float ClampVelocityOnFinish = 0.0f
 	);
+	virtual void ResetAction() override;
+	virtual TSharedPtr<FAction> CloneAction() const override;
 
 	virtual EActionResult ExecuteAction() override;
-	virtual bool FinishAction(EActionResult InResult, const FString& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
+	virtual bool FinishAction(EActionResult InResult, const FActionFinishReason& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
 	virtual EActionResult TickAction(float DeltaTime) override;
+	virtual bool NeedsTick() const override { return Duration >= 0.f; }
 protected:
 
 	FVector WorldDirection;
@@ -8,31 +8,22 @@ DEFINE_LOG_CATEGORY(LogAction_RootMotionForce);
 
 bool FAction_RootMotionForce::HasTimedOut() const
 {
-	ACharacter* Character = Cast<ACharacter>(GetOwner());
-	if (Character)
+	UCharacterMovementComponent *MovementComponent = GetOwnerContext().Movement;
+	const TSharedPtr<FRootMotionSource> RMS = (MovementComponent ? MovementComponent->GetRootMotionSourceByID(RootMotionSourceID) : nullptr);
+	if (!RMS.IsValid())
 	{
-		UCharacterMovementComponent *MovementComponent = Character->GetCharacterMovement();
-		const TSharedPtr<FRootMotionSource> RMS = (MovementComponent ? MovementComponent->GetRootMotionSourceByID(RootMotionSourceID) : nullptr);
-		if (!RMS.IsValid())
-		{
-			return true;
-		}
-		return RMS->Status.HasFlag(ERootMotionSourceStatusFlags::Finished);
+		return true;
 	}
-	return true;
+	return RMS->Status.HasFlag(ERootMotionSourceStatusFlags::Finished);
 }
 
 float FAction_RootMotionForce::GetTimeRadio() const
 {
-	ACharacter *Character = Cast<ACharacter>(GetOwner());
-	if (Character)
+	UCharacterMovementComponent *MovementComponent = GetOwnerContext().Movement;
+	const TSharedPtr<FRootMotionSource> RMS = (MovementComponent ? MovementComponent->GetRootMotionSourceByID(RootMotionSourceID) : nullptr);
+	if (RMS.IsValid() && RMS->Duration != 0.0f)
 	{
-		UCharacterMovementComponent *MovementComponent = Character->GetCharacterMovement();
-		const TSharedPtr<FRootMotionSource> RMS = (MovementComponent ? MovementComponent->GetRootMotionSourceByID(RootMotionSourceID) : nullptr);
-		if (RMS.IsValid() && RMS->Duration != 0.0f)
-		{
-			return RMS->CurrentTime / RMS->Duration;
-		}
+		return RMS->CurrentTime / RMS->Duration;
 	}
 	return 0.0f;
 }
@@ -16,6 +16,8 @@ NEWPROJECT_API DECLARE_LOG_CATEGORY_EXTERN(LogAction_RootMotionForce, Warning, A
 class NEWPROJECT_API FAction_RootMotionForce : public FAction
 {
 public:
+	DECLARE_ACTION_CLASS()
+
 	FAction_RootMotionForce() { Type = (EActionType::Animation | EActionType::Move | EActionType::Rotate); }
 
 	virtual bool HasTimedOut() const;
@@ -1,13 +1,14 @@
 // Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
 
 #include "Action_RootMotionJump.h"
+#include "ActionPool.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/Character.h"
 
 
 TSharedPtr<FAction_RootMotionJump> FAction_RootMotionJump::CreateAction(FVector WorldDirection, float Strength, float Duration /*= -1.0*/, bool bIsAdditive /*= false*/, UCurveFloat* StrengthOverTime /*= nullptr*/, ERootMotionFinishVelocityMode VelocityOnFinishMode /*= ERootMotionFinishVelocityMode::MaintainLastRootMotionVelocity*/, FVector SetVelocityOnFinish /*= FVector::ZeroVector*/, float ClampVelocityOnFinish /*= 0.0f */)
 {
-	TSharedPtr<FAction_RootMotionJump> Action = MakeShareable(new FAction_RootMotionJump());
+	TSharedPtr<FAction_RootMotionJump> Action = TActionPool<FAction_RootMotionJump>::Acquire();
 
 	if (Action.IsValid())
 	{
@@ -31,10 +32,20 @@ TSharedPtr<FAction_RootMotionJump> FAction_RootMotionJump::CreateAction(FVector
 	return Action;
 }
 
+void FAction_RootMotionJump::ResetAction()
+{
+	*this = FAction_RootMotionJump();
+}
+
+TSharedPtr<FAction> FAction_RootMotionJump::CloneAction() const
+{
+	return TActionPool<FAction_RootMotionJump>::Clone(*this);
+}
+
 EActionResult FAction_RootMotionJump::ExecuteAction()
 {
 	EActionResult Result = EActionResult::Wait;
-	ACharacter *Character = Cast<ACharacter>(GetOwner());
+	ACharacter *Character = GetOwnerContext().Character;
 	UCharacterMovementComponent *MovementComponent = nullptr;
 	if (Character)
 	{
@@ -53,9 +64,9 @@ EActionResult FAction_RootMotionJump::ExecuteAction()
 	return Result;
 }
 
-bool FAction_RootMotionJump::FinishAction(EActionResult InResult, const FString& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
+bool FAction_RootMotionJump::FinishAction(EActionResult InResult, const FActionFinishReason& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
 {
-	ACharacter *Character = Cast<ACharacter>(GetOwner());
+	ACharacter *Character = GetOwnerContext().Character;
 	UCharacterMovementComponent *MovementComponent = nullptr;
 	if (Character)
 	{
@@ -1,12 +1,13 @@
 // Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
 
 #include "Action_RootMotionMoveToActor.h"
+#include "ActionPool.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/Character.h"
 
 TSharedPtr<FAction_RootMotionMoveToActor> FAction_RootMotionMoveToActor::CreateAction(AActor* InTargetActor, float Duration /*= FLT_MAX*/, bool bSetNewMovementMode /*= false*/, EMovementMode MovementMode /*= MOVE_Flying*/, bool bRestrictSpeedToExpected /*= false*/, UCurveVector* PathOffsetCurve /*= nullptr*/, ERootMotionFinishVelocityMode VelocityOnFinishMode /*= ERootMotionFinishVelocityMode::MaintainLastRootMotionVelocity*/, FVector SetVelocityOnFinish /*= FVector::ZeroVector*/, float ClampVelocityOnFinish /*= 0.0f*/, float InPlayRate /*= 1.f*/, FName InStartSectionName /*= NAME_None*/)
 {
-	TSharedPtr<FAction_RootMotionMoveToActor> Action = MakeShareable(new FAction_RootMotionMoveToActor());
+	TSharedPtr<FAction_RootMotionMoveToActor> Action = TActionPool<FAction_RootMotionMoveToActor>::Acquire();
 	if (Action.IsValid())
 	{
 		Action->TargetActor = InTargetActor;
@@ -22,10 +23,20 @@ TSharedPtr<FAction_RootMotionMoveToActor> FAction_RootMotionMoveToActor::CreateA
 	return Action;
 }
 
+void FAction_RootMotionMoveToActor::ResetAction()
+{
+	*this = FAction_RootMotionMoveToActor();
+}
+
+TSharedPtr<FAction> FAction_RootMotionMoveToActor::CloneAction() const
+{
+	return TActionPool<FAction_RootMotionMoveToActor>::Clone(*this);
+}
+
 EActionResult FAction_RootMotionMoveToActor::ExecuteAction()
 {
 	EActionResult Result = EActionResult::Wait;
-	ACharacter *Character = Cast<ACharacter>(GetOwner());
+	ACharacter *Character = GetOwnerContext().Character;
 	UCharacterMovementComponent *MovementComp = nullptr;
 	if (Character)
 	{
@@ -52,7 +63,7 @@ EActionResult FAction_RootMotionMoveToActor::ExecuteAction()
 	return Result;
 }
 
-bool FAction_RootMotionMoveToActor::FinishAction(EActionResult InResult, const FString& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
+bool FAction_RootMotionMoveToActor::FinishAction(EActionResult InResult, const FActionFinishReason& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
 {
 	return true;
 }
@@ -23,6 +23,8 @@ NEWPROJECT_API DECLARE_LOG_CATEGORY_EXTERN(LogAction_RootMotionMoveToActor, Warn
 class NEWPROJECT_API FAction_RootMotionMoveToActor : public FAction_RootMotionForce
 {
 public:
+	DECLARE_ACTION_CLASS()
+
 	FAction_RootMotionMoveToActor() { Type = EActionType::Animation | EActionType::Move | EActionType::Rotate; }
 
 	static TSharedPtr<FAction_RootMotionMoveToActor> CreateAction(
@@ -37,9 +39,11 @@ public:
 		float ClampVelocityOnFinish = 0.0f,
 		float InPlayRate = 1.f,
 		FName InStartSectionName = NAME_None);
+	virtual void ResetAction() override;
+	virtual TSharedPtr<FAction> CloneAction() const override;
 
 	virtual EActionResult ExecuteAction() override;
-	virtual bool FinishAction(EActionResult InResult, const FString& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
+	virtual bool FinishAction(EActionResult InResult, const FActionFinishReason& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
 	virtual EActionResult TickAction(float DeltaTime) override;
 protected:
 
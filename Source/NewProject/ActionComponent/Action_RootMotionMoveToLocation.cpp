@@ -1,12 +1,13 @@
 // Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
 
 #include "Action_RootMotionMoveToLocation.h"
+#include "ActionPool.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/Character.h"
 
 TSharedPtr<FAction_RootMotionMoveToLocation> FAction_RootMotionMoveToLocation::CreateAction(FVector TargetLocation, float Duration /*= FLT_MAX*/, bool bSetNewMovementMode /*= false*/, EMovementMode MovementMode /*= MOVE_Flying*/, bool bRestrictSpeedToExpected /*= false*/, UCurveVector* PathOffsetCurve /*= nullptr*/, ERootMotionFinishVelocityMode VelocityOnFinishMode /*= ERootMotionFinishVelocityMode::MaintainLastRootMotionVelocity*/, FVector SetVelocityOnFinish /*= FVector::ZeroVector*/, float ClampVelocityOnFinish /*= 0.0f*/, float InPlayRate /*= 1.f*/, FName InStartSectionName /*= NAME_None*/)
 {
-	TSharedPtr<FAction_RootMotionMoveToLocation> Action = MakeShareable(new FAction_RootMotionMoveToLocation());
+	TSharedPtr<FAction_RootMotionMoveToLocation> Action = TActionPool<FAction_RootMotionMoveToLocation>::Acquire();
 	if (Action.IsValid())
 	{
 		Action->TargetLocation = TargetLocation;
@@ -22,10 +23,20 @@ TSharedPtr<FAction_RootMotionMoveToLocation> FAction_RootMotionMoveToLocation::C
 	return Action;
 }
 
+void FAction_RootMotionMoveToLocation::ResetAction()
+{
+	*this = FAction_RootMotionMoveToLocation();
+}
+
+TSharedPtr<FAction> FAction_RootMotionMoveToLocation::CloneAction() const
+{
+	return TActionPool<FAction_RootMotionMoveToLocation>::Clone(*this);
+}
+
 EActionResult FAction_RootMotionMoveToLocation::ExecuteAction()
 {
 	EActionResult Result = EActionResult::Wait;
-	ACharacter *Character = Cast<ACharacter>(GetOwner());
+	ACharacter *Character = GetOwnerContext().Character;
 	UCharacterMovementComponent *MovementComp = nullptr;
 	if (Character)
 	{
@@ -55,7 +66,7 @@ EActionResult FAction_RootMotionMoveToLocation::ExecuteAction()
 	return Result;
 }
 
-bool FAction_RootMotionMoveToLocation::FinishAction(EActionResult InResult, const FString& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
+bool FAction_RootMotionMoveToLocation::FinishAction(EActionResult InResult, const FActionFinishReason& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
 {
 	return true;
 }
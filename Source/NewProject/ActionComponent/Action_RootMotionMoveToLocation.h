@@ -13,6 +13,8 @@ NEWPROJECT_API DECLARE_LOG_CATEGORY_EXTERN(LogAction_RootMotionMoveToLocation, W
 class NEWPROJECT_API FAction_RootMotionMoveToLocation : public FAction_RootMotionForce
 {
 public:
+	DECLARE_ACTION_CLASS()
+
 	FAction_RootMotionMoveToLocation() { Type = EActionType::Animation | EActionType::Move | EActionType::Rotate; }
 
 	static TSharedPtr<FAction_RootMotionMoveToLocation> CreateAction(
@@ -27,9 +29,11 @@ public:
 		float ClampVelocityOnFinish = 0.0f,
 		float InPlayRate = 1.f,
 		FName InStartSectionName = NAME_None);
+	virtual void ResetAction() override;
+	virtual TSharedPtr<FAction> CloneAction() const override;
 
 	virtual EActionResult ExecuteAction() override;
-	virtual bool FinishAction(EActionResult InResult, const FString& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
+	virtual bool FinishAction(EActionResult InResult, const FActionFinishReason& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
 	virtual EActionResult TickAction(float DeltaTime) override;
 protected:
 
@@ -1,6 +1,7 @@
 // Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
 
 #include "Action_RootMotionRadial.h"
+#include "ActionPool.h"
 #include "GameFramework/Character.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Curves/CurveFloat.h"
@@ -78,7 +79,7 @@ void FRootMotionSource_NewRadialForce::PrepareRootMotion(float SimulationTime, f
 
 TSharedPtr<FAction_RootMotionRadial> FAction_RootMotionRadial::CreateAction(FVector Location, AActor* LocationActor /*= nullptr*/, float Strength /*= 100.0f*/, float Duration /*= -1.0f*/, float Radius /*= 100.0f*/, bool bIsPush /*= true*/, bool bIsAdditive /*= true*/, bool bNoZForce /*= true*/, UCurveFloat* StrengthDistanceFalloff /*= nullptr*/, UCurveFloat* StrengthOverTime /*= nullptr*/, bool bUseFixedWorldDirection /*= false*/, FRotator FixedWorldDirection /*= FRotator(0.0f, 0.0f, 0.0f)*/, ERootMotionFinishVelocityMode VelocityOnFinishMode /*= ERootMotionFinishVelocityMode::MaintainLastRootMotionVelocity*/, FVector SetVelocityOnFinish /*= FVector::ZeroVector*/, float ClampVelocityOnFinish /*= 0.0f*/)
 {
-	TSharedPtr<FAction_RootMotionRadial> Action = MakeShareable(new FAction_RootMotionRadial());
+	TSharedPtr<FAction_RootMotionRadial> Action = TActionPool<FAction_RootMotionRadial>::Acquire();
 	if (Action.IsValid())
 	{
 		Action->TargetLocation = Location;
@@ -110,9 +111,19 @@ TSharedPtr<FAction_RootMotionRadial> FAction_RootMotionRadial::CreateAction(FVec
 	return Action;
 }
 
+void FAction_RootMotionRadial::ResetAction()
+{
+	*this = FAction_RootMotionRadial();
+}
+
+TSharedPtr<FAction> FAction_RootMotionRadial::CloneAction() const
+{
+	return TActionPool<FAction_RootMotionRadial>::Clone(*this);
+}
+
 EActionResult FAction_RootMotionRadial::ExecuteAction()
 {
-	ACharacter *Character = Cast<ACharacter>(GetOwner());
+	ACharacter *Character = GetOwnerContext().Character;
 	UCharacterMovementComponent *MovementComponent = nullptr;
 	if (Character)
 	{
@@ -147,9 +158,9 @@ EActionResult FAction_RootMotionRadial::ExecuteAction()
 	return EActionResult::Wait;
 }
 
-bool FAction_RootMotionRadial::FinishAction(EActionResult InResult, const FString& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
+bool FAction_RootMotionRadial::FinishAction(EActionResult InResult, const FActionFinishReason& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
 {
-	ACharacter *Character = Cast<ACharacter>(GetOwner());
+	ACharacter *Character = GetOwnerContext().Character;
 	UCharacterMovementComponent *MovementComponent = nullptr;
 	if (Character)
 	{
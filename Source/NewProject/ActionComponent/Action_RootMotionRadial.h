@@ -37,13 +37,18 @@ struct NEWPROJECT_API TStructOpsTypeTraits<FRootMotionSource_NewRadialForce> : p
 class NEWPROJECT_API FAction_RootMotionRadial : public FAction_RootMotionForce
 {
 public:
+	DECLARE_ACTION_CLASS()
+
 	FAction_RootMotionRadial() { Type = EActionType::Move; }
 
 	static TSharedPtr<FAction_RootMotionRadial> CreateAction(FVector Location, AActor* LocationActor = nullptr, float Strength = 100.0f, float Duration = -1.0f, float Radius = 100.0f, bool bIsPush = true, bool bIsAdditive = true, bool bNoZForce = true, UCurveFloat* StrengthDistanceFalloff = nullptr, UCurveFloat* StrengthOverTime = nullptr, bool bUseFixedWorldDirection = false, FRotator FixedWorldDirection = FRotator(0.0f, 0.0f, 0.0f), ERootMotionFinishVelocityMode VelocityOnFinishMode = ERootMotionFinishVelocityMode::MaintainLastRootMotionVelocity, FVector SetVelocityOnFinish = FVector::ZeroVector, float ClampVelocityOnFinish = 0.0f);
+	virtual void ResetAction() override;
+	virtual TSharedPtr<FAction> CloneAction() const override;
 
 	virtual EActionResult ExecuteAction() override;
-	virtual bool FinishAction(EActionResult InResult, const FString& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
+	virtual bool FinishAction(EActionResult InResult, const FActionFinishReason& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
 	virtual EActionResult TickAction(float DeltaTime) override;
+	virtual bool NeedsTick() const override { return Duration >= 0.f; }
 
 protected:
 	FVector TargetLocation;
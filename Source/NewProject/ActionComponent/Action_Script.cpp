@@ -0,0 +1,196 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "Action_Script.h"
+#include "ActionPool.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Script Steps"), STAT_ActionScriptSteps, STATGROUP_ActionComponent);
+
+TSharedPtr<FAction_Script> FAction_Script::AcquireScript(EActionType InType)
+{
+	TSharedPtr<FAction_Script> Action = TActionPool<FAction_Script>::Acquire();
+	if (Action.IsValid())
+	{
+		Action->DeclaredType = InType;
+		Action->NotifyTypeChanged();
+	}
+	return Action;
+}
+
+void FAction_Script::ResetAction()
+{
+	*this = FAction_Script();
+}
+
+TSharedPtr<FAction> FAction_Script::CloneAction() const
+{
+	TSharedPtr<FAction_Script> Action = TActionPool<FAction_Script>::Acquire();
+	if (Action.IsValid())
+	{
+		static_cast<FAction&>(*Action) = *this;
+		Action->DetachCopy();
+		Action->Body = Body;
+		Action->Context.Step = Context.Step;
+		Action->Context.LastResult = Context.LastResult;
+		Action->DeclaredType = DeclaredType;
+		Action->bChildRunning = bChildRunning;
+		Action->bStepPending = bStepPending;
+		if (Child.IsValid())
+		{
+			Action->Child = Child->CloneAction();
+			Action->Child->ParentAction = Action;
+		}
+	}
+	return Action;
+}
+
+void FAction_Script::RearmAction()
+{
+	Context = FActionScriptContext();
+	Child.Reset();
+	bChildRunning = false;
+	bStepPending = false;
+	UpdateType();
+}
+
+bool FAction_Script::ForEachActiveAction(TFunctionRef<bool(const FAction*)> Visitor) const
+{
+	return !bChildRunning || Child->ForEachActiveAction(Visitor);
+}
+
+bool FAction_Script::NeedsTick() const
+{
+	return bStepPending || (bChildRunning && Child->NeedsTick());
+}
+
+FName FAction_Script::GetName() const
+{
+	return TEXT("Action_Script");
+}
+
+FString FAction_Script::GetDescription() const
+{
+	return FString::Printf(TEXT("%s (Step:%d, Await:{%s})"), *GetName().ToString(), Context.Step, bChildRunning ? *Child->GetDescription() : TEXT(""));
+}
+
+EActionResult FAction_Script::ExecuteAction()
+{
+	if (!Body.IsBound())
+		return EActionResult::Fail;
+
+	Context = FActionScriptContext();
+	bChildRunning = false;
+	bStepPending = false;
+	const EActionResult Result = RunSteps();
+	NotifyTypeChanged();
+	return Result;
+}
+
+EActionResult FAction_Script::RunSteps()
+{
+	for (int32 NumInstant = 0; NumInstant < MaxInstantSteps; ++NumInstant)
+	{
+		INC_DWORD_STAT(STAT_ActionScriptSteps);
+		Context.Awaited.Reset();
+		const EActionResult Result = Body.Execute(Context);
+		if (Result != EActionResult::Wait)
+		{
+			Child.Reset();
+			return Result;
+		}
+
+		Child = MoveTemp(Context.Awaited);
+		if (!Child.IsValid())
+		{
+			Context.LastResult = EActionResult::Fail;
+			continue;
+		}
+
+		Child->ParentAction = AsShared();
+		Child->SetActionComponent(GetActionComponent());
+		Child->SetOwner(GetOwner());
+		Context.LastResult = Child->DoExecuteAction();
+		if (Context.LastResult == EActionResult::Wait)
+		{
+			bChildRunning = true;
+			return EActionResult::Wait;
+		}
+	}
+
+	bStepPending = true;
+	RequestTick();
+	return EActionResult::Wait;
+}
+
+bool FAction_Script::FinishAction(EActionResult InResult, const FActionFinishReason& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
+{
+	bStepPending = false;
+	if (!bChildRunning)
+		return true;
+
+	bChildRunning = false;
+	if (Child->DoFinishAction(InResult, Reason, StopType) == false)
+	{
+		bChildRunning = true;
+		NotifyTypeChanged();
+		return false;
+	}
+	return true;
+}
+
+EActionResult FAction_Script::TickAction(float DeltaTime)
+{
+	if (bStepPending)
+	{
+		bStepPending = false;
+		const EActionResult Result = RunSteps();
+		NotifyTypeChanged();
+		return Result;
+	}
+
+	if (!bChildRunning)
+		return EActionResult::Abort;
+
+	const EActionResult Result = Child->DoTickAction(DeltaTime);
+	if (Result != EActionResult::Wait)
+	{
+		FinishChildAction(Child.Get(), Result);
+	}
+	return EActionResult::Wait;
+}
+
+void FAction_Script::UpdateType()
+{
+	Type = DeclaredType;
+	if (bChildRunning)
+	{
+		Type |= Child->GetType();
+	}
+}
+
+bool FAction_Script::FinishChildAction(FAction* InAction, EActionResult InResult, const FActionFinishReason& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
+{
+	if (!InAction || !bChildRunning || InAction != Child.Get())
+		return true;
+
+	bChildRunning = false;
+	if (InAction->DoFinishAction(InResult, Reason, StopType) == false)
+	{
+		bChildRunning = true;
+		NotifyTypeChanged();
+		return false;
+	}
+
+	// The finished child may still be on the stack, holding it keeps its pool from handing it to the next await.
+	const TSharedPtr<FAction> Finished = Child;
+	Context.LastResult = InResult;
+	const EActionResult Result = RunSteps();
+	if (Result != EActionResult::Wait)
+	{
+		NotifyActionFinish(Result, Reason);
+	}
+	else
+	{
+		NotifyTypeChanged();
+	}
+	return true;
+}
@@ -0,0 +1,115 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Action.h"
+
+/** State a script body resumes from, the body's own state lives in its captures since locals do not survive an await. */
+struct FActionScriptContext
+{
+	/** Resume point set by ACTION_AWAIT, zero at the start. */
+	int32 Step = 0;
+	/** Result of the last awaited action, Fail when it could not be created. */
+	EActionResult LastResult = EActionResult::Success;
+	/** Action the body suspends on, set by ACTION_AWAIT. */
+	TSharedPtr<FAction> Awaited;
+};
+
+/** Opens a script body, every ACTION_AWAIT must sit directly within the body between it and ACTION_SCRIPT_END. */
+#define ACTION_SCRIPT_BEGIN(Ctx) switch ((Ctx).Step) { case 0:
+
+/** Runs InAction as the script's child and resumes once it finished, the script fails with it unless it succeeded. */
+#define ACTION_AWAIT(Ctx, InAction) \
+	do \
+	{ \
+		(Ctx).Awaited = (InAction); \
+		(Ctx).Step = __LINE__; \
+		return EActionResult::Wait; \
+		case __LINE__: \
+		if ((Ctx).LastResult != EActionResult::Success) \
+			return (Ctx).LastResult; \
+	} while (0)
+
+/** Like ACTION_AWAIT but always resumes, the body reads the outcome from Ctx.LastResult. */
+#define ACTION_AWAIT_ANY(Ctx, InAction) \
+	do \
+	{ \
+		(Ctx).Awaited = (InAction); \
+		(Ctx).Step = __LINE__; \
+		return EActionResult::Wait; \
+		case __LINE__:; \
+	} while (0)
+
+#define ACTION_SCRIPT_END(Ctx) } return EActionResult::Success
+
+/**
+ * A multi-step behaviour written as one resumable function instead of a tree of sequences and parallels:
+ *
+ *	FAction_Script::CreateAction([Target](FActionScriptContext& Ctx)
+ *	{
+ *		ACTION_SCRIPT_BEGIN(Ctx);
+ *		ACTION_AWAIT(Ctx, FAction_SimpleMoveTo::CreateAction(Target));
+ *		ACTION_AWAIT(Ctx, FAction_Wait::CreateAction(0.5f));
+ *		ACTION_SCRIPT_END(Ctx);
+ *	});
+ *
+ * The body returns Wait to await Ctx.Awaited and is resumed from that child's completion, the awaited actions come
+ * from their pools. The script takes the type of the awaited action, so stopping that type stops the script.
+ */
+class NEWPROJECT_API FAction_Script : public FAction
+{
+public:
+	DECLARE_ACTION_CLASS()
+
+	typedef TActionCallback<EActionResult(FActionScriptContext&)> FScriptBody;
+
+	FAction_Script() { Type = EActionType::Default; }
+
+	/** InType is claimed for the whole run, on top of the type of the awaited action, so conflicts are resolved before the first await. */
+	template<typename FunctorType>
+	static TSharedPtr<FAction_Script> CreateAction(FunctorType&& InBody, EActionType InType = EActionType::Default)
+	{
+		TSharedPtr<FAction_Script> Action = AcquireScript(InType);
+		if (Action.IsValid())
+		{
+			Action->Body.BindLambda(Forward<FunctorType>(InBody));
+		}
+		return Action;
+	}
+	virtual void ResetAction() override;
+	virtual TSharedPtr<FAction> CloneAction() const override;
+	/** Restarts the body from the top, captured state is left to the body. */
+	virtual void RearmAction() override;
+
+	virtual bool ForEachActiveAction(TFunctionRef<bool(const FAction*)> Visitor) const override;
+	virtual bool NeedsTick() const override;
+
+	virtual FName GetName() const override;
+	virtual FString GetDescription() const override;
+
+	/** Steps a body may run through without waiting within one call before the next is left to the following tick. */
+	static const int32 MaxInstantSteps = 64;
+
+protected:
+	virtual EActionResult ExecuteAction() override;
+	virtual bool FinishAction(EActionResult InResult, const FActionFinishReason& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
+	virtual EActionResult TickAction(float DeltaTime) override;
+
+	virtual void UpdateType() override;
+
+	virtual bool FinishChildAction(FAction* InAction, EActionResult InResult, const FActionFinishReason& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
+
+	static TSharedPtr<FAction_Script> AcquireScript(EActionType InType);
+
+	/** Resumes the body until it awaits an action that has to wait, returns Wait or the result of the script. */
+	EActionResult RunSteps();
+
+	FScriptBody Body;
+	FActionScriptContext Context;
+	EActionType DeclaredType = EActionType::Default;
+
+	TSharedPtr<FAction> Child;
+	bool bChildRunning = false;
+	/** The next step was deferred to TickAction after MaxInstantSteps. */
+	bool bStepPending = false;
+};
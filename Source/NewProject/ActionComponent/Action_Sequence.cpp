@@ -1,29 +1,113 @@
 // Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
 
 #include "Action_Sequence.h"
+#include "ActionPool.h"
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sequence Steps"), STAT_ActionSequenceSteps, STATGROUP_ActionComponent);
 
 TSharedPtr<FAction_Sequence> FAction_Sequence::CreateAction(const std::initializer_list<TSharedPtr<FAction>>& InActions)
 {
-	TSharedPtr<FAction_Sequence> Action = MakeShareable(new FAction_Sequence());
+	return CreateFromRange(InActions, (int32)InActions.size());
+}
+
+TSharedPtr<FAction_Sequence> FAction_Sequence::CreateAction(const TArray<TSharedPtr<FAction>>& InActions)
+{
+	return CreateFromRange(InActions, InActions.Num());
+}
+
+template<typename RangeType>
+TSharedPtr<FAction_Sequence> FAction_Sequence::CreateFromRange(const RangeType& InActions, int32 NumActions)
+{
+	TSharedPtr<FAction_Sequence> Action = TActionPool<FAction_Sequence>::Acquire();
 	if (Action.IsValid())
 	{
+		Action->Sequence.Reserve(NumActions);
 		for (auto& SingleAction : InActions)
 		{
-			SingleAction->ParentAction = Action;
-			Action->Sequence.Add(SingleAction);
+			if (SingleAction.IsValid())
+			{
+				SingleAction->ParentAction = Action;
+				Action->Sequence.Add(SingleAction);
+			}
 		}
 		Action->NotifyTypeChanged();
 	}
 	return Action;
 }
 
-TArray<const FAction*> FAction_Sequence::GetActiveActions() const
+void FAction_Sequence::ResetAction()
 {
-	if (Sequence.Num() > 0 && Sequence[0].IsValid())
-		return Sequence[0]->GetActiveActions();
-	else
-		return {};
+	*this = FAction_Sequence();
+}
+
+TSharedPtr<FAction> FAction_Sequence::CloneAction() const
+{
+	TSharedPtr<FAction_Sequence> Action = TActionPool<FAction_Sequence>::Acquire();
+	if (Action.IsValid())
+	{
+		static_cast<FAction&>(*Action) = *this;
+		Action->DetachCopy();
+		Action->Sequence.Reserve(Sequence.Num());
+		for (const TSharedPtr<FAction>& Child : Sequence)
+		{
+			TSharedPtr<FAction> ChildClone = Child.IsValid() ? Child->CloneAction() : nullptr;
+			if (ChildClone.IsValid())
+			{
+				ChildClone->ParentAction = Action;
+			}
+			Action->Sequence.Add(ChildClone);
+		}
+		Action->Cursor = Cursor;
+		Action->NumReleased = NumReleased;
+		Action->bRetainFinished = bRetainFinished;
+	}
+	return Action;
+}
+
+void FAction_Sequence::RearmAction()
+{
+	if (!ensureMsgf(NumReleased == 0, TEXT("%s released its finished children, only a retained sequence can be rearmed"), *GetName().ToString()))
+		return;
+
+	for (const TSharedPtr<FAction>& Child : Sequence)
+	{
+		Child->RearmAction();
+	}
+	Cursor = 0;
+	UpdateType();
+}
+
+void FAction_Sequence::RetainFinishedChildren()
+{
+	bRetainFinished = true;
+	for (const TSharedPtr<FAction>& Child : Sequence)
+	{
+		if (Child.IsValid())
+		{
+			Child->RetainFinishedChildren();
+		}
+	}
+}
+
+void FAction_Sequence::ReleaseFinished(int32 EndIndex)
+{
+	if (bRetainFinished)
+		return;
+
+	for (; NumReleased < EndIndex; ++NumReleased)
+	{
+		Sequence[NumReleased].Reset();
+	}
+}
+
+bool FAction_Sequence::ForEachActiveAction(TFunctionRef<bool(const FAction*)> Visitor) const
+{
+	return !Sequence.IsValidIndex(Cursor) || Sequence[Cursor]->ForEachActiveAction(Visitor);
+}
+
+bool FAction_Sequence::NeedsTick() const
+{
+	return Sequence.IsValidIndex(Cursor) && Sequence[Cursor]->NeedsTick();
 }
 
 FName FAction_Sequence::GetName() const
@@ -36,7 +120,7 @@ FString FAction_Sequence::GetDescription() const
 	FString SequenceString;
 	for (auto &Action : Sequence)
 	{
-		SequenceString += Action->GetDescription() + TEXT(", ");
+		SequenceString += (Action.IsValid() ? Action->GetDescription() : FString(TEXT("<released>"))) + TEXT(", ");
 	}
 	SequenceString.RemoveFromEnd(TEXT(", "));
 	return FString::Printf(TEXT("%s (Sequence:{%s})"), *GetName().ToString(), *SequenceString);
@@ -44,44 +128,46 @@ FString FAction_Sequence::GetDescription() const
 
 EActionResult FAction_Sequence::ExecuteAction()
 {
-	if (Sequence.Num() == 0)
-		return EActionResult::Success;
-	for (auto& Action : Sequence)
+	if (!ensureMsgf(NumReleased == 0, TEXT("%s released its finished children, only a retained sequence can run again"), *GetName().ToString()))
+		return EActionResult::Fail;
+
+	Cursor = 0;
+	EActionResult Result = ExecuteFromCursor();
+	if (Result != EActionResult::Wait)
 	{
-		if (!Action.IsValid())
-			return EActionResult::Fail;
+		Cursor = Sequence.Num();
+	}
+	NotifyTypeChanged();
+	return Result;
+}
+
+EActionResult FAction_Sequence::ExecuteFromCursor()
+{
+	for (; Cursor < Sequence.Num(); ++Cursor)
+	{
+		INC_DWORD_STAT(STAT_ActionSequenceSteps);
+		ReleaseFinished(Cursor - 1);
+		FAction* Action = Sequence[Cursor].Get();
 		Action->SetActionComponent(GetActionComponent());
 		Action->SetOwner(GetOwner());
 		EActionResult Result = Action->DoExecuteAction();
-		if (Result != EActionResult::Wait)
-		{
-			if (Result == EActionResult::Fail)
-				return EActionResult::Fail;
-			if (Result == EActionResult::Success)
-				Action.Reset();
-		}
-		else
-		{
-			break;
-		}
+		if (Result != EActionResult::Success)
+			return Result;
 	}
-	Sequence.RemoveAll([](const TSharedPtr<FAction>& Action) { return !Action.IsValid(); });
-	NotifyTypeChanged();
-
-	return Sequence.Num() == 0 ? EActionResult::Success : EActionResult::Wait;
+	return EActionResult::Success;
 }
 
-bool FAction_Sequence::FinishAction(EActionResult InResult, const FString& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
+bool FAction_Sequence::FinishAction(EActionResult InResult, const FActionFinishReason& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
 {
-	if (Sequence.Num() == 0 || !Sequence[0].IsValid())
+	if (!Sequence.IsValidIndex(Cursor))
 	{
 		return true;
 	}
-	TSharedPtr<FAction> CurAction = Sequence[0];
-	Sequence[0].Reset();
-	if (CurAction->DoFinishAction(InResult, Reason, StopType) == false)
+	const int32 Current = Cursor;
+	Cursor = Sequence.Num();
+	if (Sequence[Current]->DoFinishAction(InResult, Reason, StopType) == false)
 	{
-		Sequence[0] = CurAction;
+		Cursor = Current;
 		NotifyTypeChanged();
 		return false;
 	}
@@ -90,12 +176,15 @@ bool FAction_Sequence::FinishAction(EActionResult InResult, const FString& Reaso
 
 EActionResult FAction_Sequence::TickAction(float DeltaTime)
 {
-	if (Sequence.Num() == 0)
+	if (!Sequence.IsValidIndex(Cursor))
 		return EActionResult::Abort;
-	EActionResult Result = Sequence[0]->DoTickAction(DeltaTime);
+	FAction* Action = Sequence[Cursor].Get();
+	EActionResult Result = Action->DoTickAction(DeltaTime);
 	if (Result != EActionResult::Wait)
 	{
-		FinishChildAction(Sequence[0].Get(), Result);
+		FinishChildAction(Action, Result);
+		// Every child that finished here has returned, none of them is on the stack any more.
+		ReleaseFinished(Cursor);
 		return EActionResult::Wait;
 	}
 	return Result;
@@ -103,70 +192,37 @@ EActionResult FAction_Sequence::TickAction(float DeltaTime)
 
 void FAction_Sequence::UpdateType()
 {
-	Type = EActionType::Default;
-	for (auto& Action : Sequence)
-	{
-		if (Action.IsValid())
-		{
-			Type = Action->GetType();
-			break;
-		}
-	}
+	Type = Sequence.IsValidIndex(Cursor) ? Sequence[Cursor]->GetType() : EActionType::Default;
 }
 
-bool FAction_Sequence::FinishChildAction(FAction* InAction, EActionResult InResult, const FString& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
+bool FAction_Sequence::FinishChildAction(FAction* InAction, EActionResult InResult, const FActionFinishReason& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
 {
-	if (InAction)
+	if (!InAction || !Sequence.IsValidIndex(Cursor) || Sequence[Cursor].Get() != InAction)
+		return true;
+
+	const int32 Current = Cursor;
+	Cursor = Sequence.Num();
+	if (InAction->DoFinishAction(InResult, Reason, StopType) == false)
 	{
-		ensure(InAction == Sequence[0].Get());
-		TSharedPtr<FAction> Action = Sequence[0];
-		Sequence[0].Reset();
-		if (Action->DoFinishAction(InResult, Reason, StopType))
-		{
-			if (InResult == EActionResult::Success)
-			{
-				for (auto& SingleAction : Sequence)
-				{
-					if (!SingleAction.IsValid())
-						continue;
-					SingleAction->SetActionComponent(GetActionComponent());
-					SingleAction->SetOwner(GetOwner());
-					InResult = SingleAction->DoExecuteAction();
-					if (InResult == EActionResult::Success)
-					{
-						SingleAction.Reset();
-					}
-					else
-					{
-						break;
-					}
-				}
-			}
+		Cursor = Current;
+		NotifyTypeChanged();
+		return false;
+	}
 
-			if (InResult == EActionResult::Fail || InResult == EActionResult::Abort || InResult == EActionResult::Clean)
-			{
-				Sequence.Empty();
-				NotifyActionFinish(InResult, Reason);
-			}
-			else
-			{
-				Sequence.RemoveAll([](const TSharedPtr<FAction>& Action) { return !Action.IsValid(); });
-				if (Sequence.Num() == 0)
-				{
-					NotifyActionFinish(InResult, Reason);
-				}
-				else
-				{
-					NotifyTypeChanged();
-				}
-			}
-		}
-		else
-		{
-			Sequence[0] = Action;
-			NotifyTypeChanged();
-			return false;
-		}
+	if (InResult == EActionResult::Success)
+	{
+		Cursor = Current + 1;
+		InResult = ExecuteFromCursor();
+	}
+
+	if (InResult != EActionResult::Wait)
+	{
+		Cursor = Sequence.Num();
+		NotifyActionFinish(InResult, Reason);
+	}
+	else
+	{
+		NotifyTypeChanged();
 	}
 	return true;
 }
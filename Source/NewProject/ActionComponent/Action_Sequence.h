@@ -6,23 +6,51 @@
 
 class NEWPROJECT_API FAction_Sequence : public FAction
 {
+	friend class FAction_Program;
 public:
+	DECLARE_ACTION_CLASS()
+
 	static TSharedPtr<FAction_Sequence> CreateAction(const std::initializer_list<TSharedPtr<FAction>>& InActions);
+	static TSharedPtr<FAction_Sequence> CreateAction(const TArray<TSharedPtr<FAction>>& InActions);
+	virtual void ResetAction() override;
+	virtual TSharedPtr<FAction> CloneAction() const override;
+	virtual void RearmAction() override;
+	virtual void RetainFinishedChildren() override;
 
-	virtual TArray<const FAction*> GetActiveActions() const override;
+	virtual bool ForEachActiveAction(TFunctionRef<bool(const FAction*)> Visitor) const override;
+	virtual bool NeedsTick() const override;
 
 	virtual FName GetName() const override;
 	virtual FString GetDescription() const override;
 
 protected:
 	virtual EActionResult ExecuteAction() override;
-	virtual bool FinishAction(EActionResult InResult, const FString& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
+	virtual bool FinishAction(EActionResult InResult, const FActionFinishReason& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
 	virtual EActionResult TickAction(float DeltaTime) override;
 
 	virtual void UpdateType() override;
 
-	virtual bool FinishChildAction(FAction* InAction, EActionResult InResult, const FString& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
+	virtual bool FinishChildAction(FAction* InAction, EActionResult InResult, const FActionFinishReason& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
+
+	template<typename RangeType>
+	static TSharedPtr<FAction_Sequence> CreateFromRange(const RangeType& InActions, int32 NumActions);
+
+	/** Executes children from Cursor on until one has to wait, returns Success once the end is reached. */
+	EActionResult ExecuteFromCursor();
 
+	/** Drops the finished children before EndIndex unless they are retained, their entries are left null. */
+	void ReleaseFinished(int32 EndIndex);
+
+	/**
+	 * Finished children are released as the sequence moves on, the one that just finished may still be on the stack and goes a step later.
+	 * Under a composite that rearms it they are retained instead, so replaying reuses both the array and the instances.
+	 */
 	TArray<TSharedPtr<FAction>> Sequence;
+
+	/** Index of the running child, Sequence.Num() when none is. */
+	int32 Cursor = 0;
+	/** Children before this index have been released. */
+	int32 NumReleased = 0;
+	bool bRetainFinished = false;
 };
 
@@ -1,15 +1,21 @@
 // Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
 
 #include "Action_ServerMoveTo.h"
+#include "ActionPool.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/Character.h"
 #include "Components/CapsuleComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+#include "ActionComponentSettings.h"
+#include "ActionFloorTraceBatch.h"
 
 DECLARE_CYCLE_STAT(TEXT("MoveTo"), STAT_ServerMoveTo, STATGROUP_AI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Floor Sweeps Avoided"), STAT_ActionFloorSweepsAvoided, STATGROUP_ActionComponent);
 
 TSharedPtr<FAction_ServerMoveTo> FAction_ServerMoveTo::CreateAction(const FVector& InDestLocation, float Speed /*= -1.0f*/, float InAcceptanceRadius /*= 1.0f*/, bool bInbWithOutControl /*= false*/)
 {
-	TSharedPtr<FAction_ServerMoveTo> Action = MakeShareable(new FAction_ServerMoveTo());
+	TSharedPtr<FAction_ServerMoveTo> Action = TActionPool<FAction_ServerMoveTo>::Acquire();
 	if (Action.IsValid())
 	{
 		Action->DestLocation = InDestLocation;
@@ -23,7 +29,7 @@ TSharedPtr<FAction_ServerMoveTo> FAction_ServerMoveTo::CreateAction(const FVecto
 
 TSharedPtr<FAction_ServerMoveTo> FAction_ServerMoveTo::CreateAction(const AActor* InGoal, float Speed /*= -1.0f*/, float InAcceptanceRadius /*= 1.0f*/, bool InbWithOutControl /*= false*/)
 {
-	TSharedPtr<FAction_ServerMoveTo> Action = MakeShareable(new FAction_ServerMoveTo());
+	TSharedPtr<FAction_ServerMoveTo> Action = TActionPool<FAction_ServerMoveTo>::Acquire();
 	if (Action.IsValid())
 	{
 		Action->Goal = InGoal;
@@ -35,9 +41,19 @@ TSharedPtr<FAction_ServerMoveTo> FAction_ServerMoveTo::CreateAction(const AActor
 	return Action;
 }
 
+void FAction_ServerMoveTo::ResetAction()
+{
+	*this = FAction_ServerMoveTo();
+}
+
+TSharedPtr<FAction> FAction_ServerMoveTo::CloneAction() const
+{
+	return TActionPool<FAction_ServerMoveTo>::Clone(*this);
+}
+
 EActionResult FAction_ServerMoveTo::ExecuteAction()
 {
-	Character = Cast<ACharacter>(GetOwner());
+	Character = GetOwnerContext().Character;
 	MovementComp = Character.IsValid() ? Character->GetCharacterMovement() : nullptr;
 	if (!MovementComp.IsValid())
 	{
@@ -63,13 +79,18 @@ EActionResult FAction_ServerMoveTo::ExecuteAction()
 	}
 	StorgeMovementMode = MovementComp->MovementMode;
 	MovementComp->SetMovementMode(MOVE_Custom, 0);
+	bFloorCached = false;
 	return EActionResult::Wait;
 }
 
-bool FAction_ServerMoveTo::FinishAction(EActionResult InResult, const FString& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
+bool FAction_ServerMoveTo::FinishAction(EActionResult InResult, const FActionFinishReason& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
 {
 	if (MovementComp.IsValid())
 	{
+		if (FActionFloorTraceBatch* FloorBatch = FActionFloorTraceBatch::Get(MovementComp->GetWorld(), false))
+		{
+			FloorBatch->CancelFloor(MovementComp.Get());
+		}
 		MovementComp->SetMovementMode(StorgeMovementMode);
 	}
 	return true;
@@ -92,9 +113,28 @@ EActionResult FAction_ServerMoveTo::TickAction(float DeltaTime)
 		FVector NewLocation;
 		bool Reached = HasReached(GoalRadius, GoalHalfHeight, CurLocation, NewLocation, DeltaTime);
 		NewLocation += FVector(0, 0, Character->GetRootComponent()->Bounds.BoxExtent.Z);
+
+		const bool bWalking = StorgeMovementMode == EMovementMode::MOVE_Walking || StorgeMovementMode == EMovementMode::MOVE_NavWalking;
+		FActionFloorTraceBatch* FloorBatch = bWalking && FActionFloorTraceBatch::IsEnabled() ? FActionFloorTraceBatch::Get(Character->GetWorld()) : nullptr;
+		if (FloorBatch)
+		{
+			ConsumeAsyncFloor(*FloorBatch);
+		}
+		const bool bFloorReused = bWalking && ReuseFloor(NewLocation);
+		bool bFloorFollowed = false;
+		if (!bFloorReused && FloorBatch && IsFloorCacheValid())
+		{
+			// Keep following the last known floor until the sweep for the new one is back, a sweep is still paid for.
+			FloorBatch->RequestFloor(MovementComp.Get(), NewLocation);
+			bFloorFollowed = FollowFloor(NewLocation);
+		}
 		Character->SetActorLocation(NewLocation);
 
-		if (StorgeMovementMode == EMovementMode::MOVE_Walking || StorgeMovementMode == EMovementMode::MOVE_NavWalking)
+		if (bFloorReused)
+		{
+			INC_DWORD_STAT(STAT_ActionFloorSweepsAvoided);
+		}
+		else if (bWalking && !bFloorFollowed)
 		{
 			float StorgeStepHeight = MovementComp->MaxStepHeight;
 			MovementComp->MaxStepHeight = MovementComp->GetCharacterOwner()->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() * 2;
@@ -102,6 +142,7 @@ EActionResult FAction_ServerMoveTo::TickAction(float DeltaTime)
 			MovementComp->AdjustFloorHeight();
 			MovementComp->SetBaseFromFloor(MovementComp->CurrentFloor);
 			MovementComp->MaxStepHeight = StorgeStepHeight;
+			CacheFloor(Character->GetActorLocation());
 		}
 		FVector Velocity = (NewLocation - CurLocation) / DeltaTime;
 		if (Reached)
@@ -187,6 +228,90 @@ void FAction_ServerMoveTo::PhysicsRotation(float DeltaTime, const FVector& Veloc
 	}
 }
 
+bool FAction_ServerMoveTo::IsFloorCacheValid() const
+{
+	const FFindFloorResult& Floor = MovementComp->CurrentFloor;
+	if (!bFloorCached || !Floor.IsWalkableFloor() || Floor.HitResult.Component.Get() != FloorBase.Get())
+		return false;
+
+	const UPrimitiveComponent* Base = FloorBase.Get();
+	return !Base || Base->Mobility == EComponentMobility::Static || Base->GetComponentTransform().Equals(FloorBaseTransform);
+}
+
+bool FAction_ServerMoveTo::ReuseFloor(FVector& NewLocation) const
+{
+	if (!IsFloorCacheValid())
+		return false;
+
+	const UActionComponentSettings* Settings = GetDefault<UActionComponentSettings>();
+	const float CacheDistance = Settings->FloorCacheRadiusScale * Character->GetCapsuleComponent()->GetScaledCapsuleRadius();
+	if (FVector::DistSquared2D(NewLocation, FloorCheckLocation) > FMath::Square(CacheDistance))
+	{
+		if (Settings->FarFloorCheckDistance <= 0.0f || GetActionTime() - FloorCheckTime >= Settings->FarFloorCheckInterval || !IsFarFromPlayers(NewLocation))
+			return false;
+	}
+	return FollowFloor(NewLocation);
+}
+
+bool FAction_ServerMoveTo::FollowFloor(FVector& NewLocation) const
+{
+	if (!bFloorCached)
+		return false;
+
+	// Follow the plane of the cached floor instead of sweeping for it.
+	const FVector Normal = MovementComp->CurrentFloor.HitResult.ImpactNormal;
+	if (Normal.Z <= KINDA_SMALL_NUMBER)
+		return false;
+	const FVector Delta = NewLocation - FloorCheckLocation;
+	NewLocation.Z = FloorCheckLocation.Z - (Normal.X * Delta.X + Normal.Y * Delta.Y) / Normal.Z;
+	return true;
+}
+
+void FAction_ServerMoveTo::CacheFloor(const FVector& Location)
+{
+	const FFindFloorResult& Floor = MovementComp->CurrentFloor;
+	UPrimitiveComponent* Base = Floor.HitResult.Component.Get();
+	FloorBase = Base;
+	FloorBaseTransform = Base ? Base->GetComponentTransform() : FTransform::Identity;
+	FloorCheckLocation = Location;
+	FloorCheckTime = GetActionTime();
+	bFloorCached = Floor.IsWalkableFloor();
+}
+
+void FAction_ServerMoveTo::ConsumeAsyncFloor(FActionFloorTraceBatch& FloorBatch)
+{
+	FFindFloorResult Floor;
+	FVector QueryLocation;
+	if (!FloorBatch.ConsumeFloor(MovementComp.Get(), Floor, QueryLocation))
+		return;
+
+	if (!Floor.IsWalkableFloor())
+	{
+		bFloorCached = false;
+		return;
+	}
+
+	// Where AdjustFloorHeight would have put the capsule at the query location.
+	const float TargetFloorDist = (UCharacterMovementComponent::MIN_FLOOR_DIST + UCharacterMovementComponent::MAX_FLOOR_DIST) * 0.5f;
+	MovementComp->CurrentFloor = Floor;
+	MovementComp->SetBaseFromFloor(Floor);
+	CacheFloor(QueryLocation - FVector(0.0f, 0.0f, Floor.FloorDist - TargetFloorDist));
+}
+
+bool FAction_ServerMoveTo::IsFarFromPlayers(const FVector& Location) const
+{
+	const float FarDistanceSquared = FMath::Square(GetDefault<UActionComponentSettings>()->FarFloorCheckDistance);
+	UWorld* World = Character->GetWorld();
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		const APawn* PlayerPawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+		if (PlayerPawn && FVector::DistSquared(PlayerPawn->GetActorLocation(), Location) < FarDistanceSquared)
+			return false;
+	}
+	return true;
+}
+
 float FAction_ServerMoveTo::GetAxisDeltaRotation(float InAxisRotationRate, float DeltaTime)
 {
 	return (InAxisRotationRate >= 0.f) ? (InAxisRotationRate * DeltaTime) : 360.f;
@@ -7,17 +7,23 @@
 class UCurveFloat;
 class UCurveVector;
 class ACharacter;
+class UPrimitiveComponent;
+class FActionFloorTraceBatch;
 class FBehaviorLock;
 
 class NEWPROJECT_API FAction_ServerMoveTo : public FAction_MoveTo
 {
 
 public:
+	DECLARE_ACTION_CLASS()
+
 	static TSharedPtr<FAction_ServerMoveTo> CreateAction(const FVector& InDestLocation, float Speed = -1.0f, float InAcceptanceRadius = 1.0f, bool bInbWithOutControl = false);
 	static TSharedPtr<FAction_ServerMoveTo> CreateAction(const AActor* InGoal, float Speed = -1.0f, float InAcceptanceRadius = 1.0f, bool InbWithOutControl = false);
+	virtual void ResetAction() override;
+	virtual TSharedPtr<FAction> CloneAction() const override;
 
 	virtual EActionResult ExecuteAction() override;
-	virtual bool FinishAction(EActionResult InResult, const FString& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
+	virtual bool FinishAction(EActionResult InResult, const FActionFinishReason& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
 	virtual EActionResult TickAction(float DeltaTime) override;
 
 	uint32 bOrientRotationToMovement : 1;
@@ -30,6 +36,17 @@ protected:
 	float GetAxisDeltaRotation(float InAxisRotationRate, float DeltaTime);
 
 	bool HasReached(float GoalRadius, float GoalHalfHeight, const FVector& CurLocation, FVector& NewLocation, float DeltaTime);
+
+	/** Whether the movement component's CurrentFloor still holds at NewLocation, in which case NewLocation is moved along the floor. */
+	bool ReuseFloor(FVector& NewLocation) const;
+	/** The cached floor is still the movement component's CurrentFloor and has not moved. */
+	bool IsFloorCacheValid() const;
+	/** Moves NewLocation onto the plane of the cached floor, however far it is from where that floor was found. */
+	bool FollowFloor(FVector& NewLocation) const;
+	void CacheFloor(const FVector& Location);
+	/** Takes over the result of an async floor sweep once it is back. */
+	void ConsumeAsyncFloor(FActionFloorTraceBatch& FloorBatch);
+	bool IsFarFromPlayers(const FVector& Location) const;
 	FRotator RotationRate = FRotator(2400.0f, 2400.0f, 2400.0f);
 
 private:
@@ -41,4 +58,11 @@ private:
 	float AcceptanceRadius;
 	bool LastHasReachedXY = false;
 	bool LastHasReachedZ = false;
+
+	/** Actor location right after the last floor check, and the transform of the floor it found. */
+	FVector FloorCheckLocation = FVector::ZeroVector;
+	FTransform FloorBaseTransform;
+	TWeakObjectPtr<UPrimitiveComponent> FloorBase;
+	float FloorCheckTime = 0.0f;
+	bool bFloorCached = false;
 };
@@ -1,6 +1,7 @@
 // Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
 
 #include "Action_SimpleMoveTo.h"
+#include "ActionPool.h"
 #include "VisualLogger.h"
 #include "NavigationSystem.h"
 #include "GameFramework/CharacterMovementComponent.h"
@@ -18,7 +19,7 @@ TSharedPtr<FAction_SimpleMoveTo> FAction_SimpleMoveTo::CreateAction(AActor* InGo
 	if (InGoal == NULL)
 		return NULL;
 
-	TSharedPtr<FAction_SimpleMoveTo> Action = MakeShareable(new FAction_SimpleMoveTo());
+	TSharedPtr<FAction_SimpleMoveTo> Action = TActionPool<FAction_SimpleMoveTo>::Acquire();
 	if (Action.IsValid())
 	{
 		Action->Goal = InGoal;
@@ -34,7 +35,7 @@ TSharedPtr<FAction_SimpleMoveTo> FAction_SimpleMoveTo::CreateAction(AActor* InGo
 
 TSharedPtr<FAction_SimpleMoveTo> FAction_SimpleMoveTo::CreateAction(const FVector& InDest, float InMaxSpeed /*= -1*/, float InAcceptanceRadius /*= 1.0f*/, bool InbUsePathfinding /*= false*/, bool InbUsePathCost /*= false*/, bool InbMoveWithAccelerate /*= false*/, bool InbWithOutControl /*= false*/, FAIMoveRequest * ExtraMoveRequest /*= nullptr*/)
 {
-	TSharedPtr<FAction_SimpleMoveTo> Action = MakeShareable(new FAction_SimpleMoveTo());
+	TSharedPtr<FAction_SimpleMoveTo> Action = TActionPool<FAction_SimpleMoveTo>::Acquire();
 	if (Action.IsValid())
 	{
 		Action->Dest = InDest;
@@ -48,11 +49,21 @@ TSharedPtr<FAction_SimpleMoveTo> FAction_SimpleMoveTo::CreateAction(const FVecto
 	return Action;
 }
 
+void FAction_SimpleMoveTo::ResetAction()
+{
+	*this = FAction_SimpleMoveTo();
+}
+
+TSharedPtr<FAction> FAction_SimpleMoveTo::CloneAction() const
+{
+	return TActionPool<FAction_SimpleMoveTo>::Clone(*this);
+}
+
 EActionResult FAction_SimpleMoveTo::ExecuteAction()
 {
 	SCOPE_CYCLE_COUNTER(STAT_MoveTo);
 
-	Character = Cast<ACharacter>(GetOwner());
+	Character = GetOwnerContext().Character;
 	if (Character.IsValid())
 	{
 		MovementComp = Character->GetCharacterMovement();
@@ -189,7 +200,7 @@ EActionResult FAction_SimpleMoveTo::ExecuteAction()
 	return EActionResult::Fail;
 }
 
-bool FAction_SimpleMoveTo::FinishAction(EActionResult InResult, const FString& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
+bool FAction_SimpleMoveTo::FinishAction(EActionResult InResult, const FActionFinishReason& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
 {
 	PathFollowingComponent->OnRequestFinished.Remove(FinishedHandle);
 	if (InResult == EActionResult::Abort)
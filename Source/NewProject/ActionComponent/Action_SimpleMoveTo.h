@@ -16,12 +16,17 @@ NEWPROJECT_API DECLARE_LOG_CATEGORY_EXTERN(LogAction_SimpleMoveTo, Warning, All)
 class NEWPROJECT_API FAction_SimpleMoveTo : public FAction_MoveTo
 {
 public:
+	DECLARE_ACTION_CLASS()
+
 	static TSharedPtr<FAction_SimpleMoveTo> CreateAction(AActor* InGoal = nullptr, float InMaxSpeed = -1, float InAcceptanceRadius = 1.0f, bool InbUsePathfinding = false, bool InbUsePathCost = false, bool InbMoveWithAccelerate = false, bool InbWithOutControl = false, FAIMoveRequest * ExtraMoveRequest = nullptr);
 	static TSharedPtr<FAction_SimpleMoveTo> CreateAction(const FVector& InDest, float InMaxSpeed = -1, float InAcceptanceRadius = 1.0f, bool InbUsePathfinding = false, bool InbUsePathCost = false, bool InbMoveWithAccelerate = false, bool InbWithOutControl = false, FAIMoveRequest * ExtraMoveRequest = nullptr);
+	virtual void ResetAction() override;
+	virtual TSharedPtr<FAction> CloneAction() const override;
 
 	virtual EActionResult ExecuteAction() override;
-	virtual bool FinishAction(EActionResult InResult, const FString& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
+	virtual bool FinishAction(EActionResult InResult, const FActionFinishReason& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
 	virtual EActionResult TickAction(float DeltaTime) override;
+	virtual bool NeedsTick() const override { return false; }
 	virtual void UpdateType() override;
 
 	TSubclassOf<UNavigationQueryFilter> DefaultNavigationFilterClass;
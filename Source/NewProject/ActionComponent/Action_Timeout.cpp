@@ -0,0 +1,205 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "Action_Timeout.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+#include "ActionComponent.h"
+#include "ActionPool.h"
+
+TSharedPtr<FAction_Timeout> FAction_Timeout::CreateAction(TSharedPtr<FAction> InAction, float InSeconds)
+{
+	if (!InAction.IsValid())
+		return nullptr;
+
+	TSharedPtr<FAction_Timeout> Action = TActionPool<FAction_Timeout>::Acquire();
+	if (Action.IsValid())
+	{
+		Action->Seconds = InSeconds;
+		Action->Child = InAction;
+		InAction->ParentAction = Action;
+		Action->NotifyTypeChanged();
+	}
+	return Action;
+}
+
+void FAction_Timeout::ResetAction()
+{
+	*this = FAction_Timeout();
+}
+
+TSharedPtr<FAction> FAction_Timeout::CloneAction() const
+{
+	TSharedPtr<FAction_Timeout> Action = TActionPool<FAction_Timeout>::Acquire();
+	if (Action.IsValid())
+	{
+		static_cast<FAction&>(*Action) = *this;
+		Action->DetachCopy();
+		Action->Seconds = Seconds;
+		Action->Deadline = Deadline;
+		Action->bChildRunning = bChildRunning;
+		if (Child.IsValid())
+		{
+			Action->Child = Child->CloneAction();
+			Action->Child->ParentAction = Action;
+		}
+	}
+	return Action;
+}
+
+void FAction_Timeout::RearmAction()
+{
+	if (Child.IsValid())
+	{
+		Child->RearmAction();
+	}
+	ClearDeadlineTimer();
+	Deadline = 0.0f;
+	bChildRunning = false;
+	UpdateType();
+}
+
+void FAction_Timeout::RetainFinishedChildren()
+{
+	if (Child.IsValid())
+	{
+		Child->RetainFinishedChildren();
+	}
+}
+
+float FAction_Timeout::GetTimeRadio() const
+{
+	if (!bChildRunning || Seconds <= 0.0f)
+		return 0.0f;
+	return FMath::Clamp(1.0f - (Deadline - GetActionTime()) / Seconds, 0.0f, 1.0f);
+}
+
+bool FAction_Timeout::ForEachActiveAction(TFunctionRef<bool(const FAction*)> Visitor) const
+{
+	return !bChildRunning || Child->ForEachActiveAction(Visitor);
+}
+
+bool FAction_Timeout::NeedsTick() const
+{
+	return bChildRunning && Child->NeedsTick();
+}
+
+FName FAction_Timeout::GetName() const
+{
+	return TEXT("Action_Timeout");
+}
+
+FString FAction_Timeout::GetDescription() const
+{
+	return FString::Printf(TEXT("%s (Seconds:%.2f, Timeout:{%s})"), *GetName().ToString(), Seconds, Child.IsValid() ? *Child->GetDescription() : TEXT(""));
+}
+
+EActionResult FAction_Timeout::ExecuteAction()
+{
+	if (!Child.IsValid())
+		return EActionResult::Fail;
+
+	Deadline = GetActionTime() + Seconds;
+	Child->SetActionComponent(GetActionComponent());
+	Child->SetOwner(GetOwner());
+	const EActionResult Result = Child->DoExecuteAction();
+	if (Result != EActionResult::Wait)
+		return Result;
+
+	bChildRunning = true;
+	UActionComponent* Component = GetActionComponent();
+	if (UWorld* World = Component ? Component->GetWorld() : nullptr)
+	{
+		World->GetTimerManager().SetTimer(DeadlineTimer, FTimerDelegate::CreateSP(this, &FAction_Timeout::OnDeadline), FMath::Max(Seconds, KINDA_SMALL_NUMBER), false);
+	}
+	NotifyTypeChanged();
+	return EActionResult::Wait;
+}
+
+bool FAction_Timeout::FinishAction(EActionResult InResult, const FActionFinishReason& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
+{
+	if (!bChildRunning)
+		return true;
+
+	bChildRunning = false;
+	if (Child->DoFinishAction(InResult, Reason, StopType) == false)
+	{
+		bChildRunning = true;
+		NotifyTypeChanged();
+		return false;
+	}
+	ClearDeadlineTimer();
+	return true;
+}
+
+EActionResult FAction_Timeout::TickAction(float DeltaTime)
+{
+	if (!bChildRunning)
+		return EActionResult::Abort;
+
+	// The timer may only fire after this tick, a child ticked here is not given time past the deadline.
+	if (CheckDeadline())
+		return EActionResult::Wait;
+
+	const EActionResult Result = Child->DoTickAction(DeltaTime);
+	if (Result != EActionResult::Wait)
+	{
+		FinishChildAction(Child.Get(), Result);
+	}
+	return EActionResult::Wait;
+}
+
+void FAction_Timeout::UpdateType()
+{
+	Type = Child.IsValid() ? Child->GetType() : EActionType::Default;
+}
+
+bool FAction_Timeout::FinishChildAction(FAction* InAction, EActionResult InResult, const FActionFinishReason& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
+{
+	if (!InAction || !bChildRunning || InAction != Child.Get())
+		return true;
+
+	bChildRunning = false;
+	if (InAction->DoFinishAction(InResult, Reason, StopType) == false)
+	{
+		bChildRunning = true;
+		NotifyTypeChanged();
+		return false;
+	}
+
+	ClearDeadlineTimer();
+	NotifyActionFinish(InResult, Reason);
+	return true;
+}
+
+bool FAction_Timeout::CheckDeadline()
+{
+	if (!bChildRunning || GetActionTime() < Deadline)
+		return false;
+	if (FinishAction(EActionResult::Abort, EActionFinishReason::Timeout) == false)
+		return false;
+
+	NotifyActionFinish(EActionResult::Fail, EActionFinishReason::Timeout);
+	return true;
+}
+
+void FAction_Timeout::OnDeadline()
+{
+	// The timer and GetActionTime advance together, this only absorbs rounding.
+	Deadline = FMath::Min(Deadline, GetActionTime());
+	// A child refusing to stop keeps running, the next tick tries again.
+	if (!CheckDeadline() && bChildRunning)
+	{
+		RequestTick();
+	}
+}
+
+void FAction_Timeout::ClearDeadlineTimer()
+{
+	UActionComponent* Component = GetActionComponent();
+	UWorld* World = Component ? Component->GetWorld() : nullptr;
+	if (World && DeadlineTimer.IsValid())
+	{
+		World->GetTimerManager().ClearTimer(DeadlineTimer);
+	}
+	DeadlineTimer.Invalidate();
+}
@@ -0,0 +1,55 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Action.h"
+#include "Engine/EngineTypes.h"
+
+/**
+ * Runs one child against a deadline on the component's clock,
+ * the child is aborted and the timeout fails with EActionFinishReason::Timeout once it passes.
+ * The deadline is in world seconds, which the owner's CustomTimeDilation does not scale even though the child's ticks are.
+ * A world timer fires it, so the timeout itself never keeps the component ticking.
+ */
+class NEWPROJECT_API FAction_Timeout : public FAction
+{
+public:
+	DECLARE_ACTION_CLASS()
+
+	FAction_Timeout() { Type = EActionType::Default; }
+
+	static TSharedPtr<FAction_Timeout> CreateAction(TSharedPtr<FAction> InAction, float InSeconds);
+	virtual void ResetAction() override;
+	virtual TSharedPtr<FAction> CloneAction() const override;
+	virtual void RearmAction() override;
+	virtual void RetainFinishedChildren() override;
+
+	virtual float GetTimeRadio() const override;
+
+	virtual bool ForEachActiveAction(TFunctionRef<bool(const FAction*)> Visitor) const override;
+	virtual bool NeedsTick() const override;
+
+	virtual FName GetName() const override;
+	virtual FString GetDescription() const override;
+
+protected:
+	virtual EActionResult ExecuteAction() override;
+	virtual bool FinishAction(EActionResult InResult, const FActionFinishReason& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
+	virtual EActionResult TickAction(float DeltaTime) override;
+
+	virtual void UpdateType() override;
+
+	virtual bool FinishChildAction(FAction* InAction, EActionResult InResult, const FActionFinishReason& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
+
+	/** Aborts the child once the deadline passed, returns true when the timeout has finished. */
+	bool CheckDeadline();
+	void OnDeadline();
+	void ClearDeadlineTimer();
+
+	TSharedPtr<FAction> Child;
+	float Seconds = 0.0f;
+	/** GetActionTime() at which the child is aborted. */
+	float Deadline = 0.0f;
+	FTimerHandle DeadlineTimer;
+	bool bChildRunning = false;
+};
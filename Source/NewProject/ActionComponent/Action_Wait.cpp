@@ -1,15 +1,26 @@
 // Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
 
 #include "Action_Wait.h"
+#include "ActionPool.h"
 #include "Engine/World.h"
 
 TSharedPtr<FAction_Wait> FAction_Wait::CreateAction(float InDelay)
 {
-	TSharedPtr<FAction_Wait> Action = MakeShareable(new FAction_Wait());
+	TSharedPtr<FAction_Wait> Action = TActionPool<FAction_Wait>::Acquire();
 	Action->Delay = InDelay;
 	return Action;
 }
 
+void FAction_Wait::ResetAction()
+{
+	*this = FAction_Wait();
+}
+
+TSharedPtr<FAction> FAction_Wait::CloneAction() const
+{
+	return TActionPool<FAction_Wait>::Clone(*this);
+}
+
 EActionResult FAction_Wait::ExecuteAction()
 {
 	if (!GetOwner())
@@ -44,7 +55,7 @@ EActionResult FAction_Wait::TickAction(float DeltaTime)
 		return EActionResult::Success;
 }
 
-bool FAction_Wait::FinishAction(EActionResult InResult, const FString& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
+bool FAction_Wait::FinishAction(EActionResult InResult, const FActionFinishReason& Reason /*= EActionFinishReason::UnKnown*/, EActionType StopType /*= EActionType::Default*/)
 {
 	if (!GetOwner())
 		return true;
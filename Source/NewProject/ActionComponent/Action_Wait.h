@@ -8,12 +8,16 @@
 class FAction_Wait : public FAction
 {
 public:
+	DECLARE_ACTION_CLASS()
+
 	FAction_Wait() { Type = EActionType::Default; }
 
 	static TSharedPtr<FAction_Wait> CreateAction(float InDelay);
+	virtual void ResetAction() override;
+	virtual TSharedPtr<FAction> CloneAction() const override;
 	virtual EActionResult ExecuteAction() override;
 	virtual EActionResult TickAction(float DeltaTime) override;
-	virtual bool FinishAction(EActionResult InResult, const FString& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
+	virtual bool FinishAction(EActionResult InResult, const FActionFinishReason& Reason = EActionFinishReason::UnKnown, EActionType StopType = EActionType::Default) override;
 
 	float Delay;
 